@@ -1123,6 +1123,21 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   void KahnsTopologicalSort(const std::function<void(const Node*)>& enter,
                             const std::function<bool(const Node*, const Node*)>& comp) const;
 
+  /** Performs topological sort with Kahn's algorithm, picking among the nodes whose inputs are ready the one that
+  grows the set of live tensors the least. A node adds the size of its outputs and releases the inputs it is the last
+  consumer of. Sizes are estimated from the inferred shapes with symbolic dimensions counted as 1.
+  @param node_orders The output node orders.
+  @returns The estimated peak size in bytes of the tensors produced by the nodes that are live at the same time.
+  */
+  size_t MemoryAwareTopologicalSort(std::vector<NodeIndex>& node_orders) const;
+
+  /** Estimates the peak size in bytes of the tensors produced by the nodes that are live at the same time, when the
+  nodes run in the given order. Graph inputs and initializers are not counted. Sizes are estimated like in
+  MemoryAwareTopologicalSort, and buffer reuse between tensors of different sizes is ignored.
+  @param node_orders The nodes of the graph in topological order.
+  */
+  size_t EstimatePeakMemory(gsl::span<const NodeIndex> node_orders) const;
+
 #endif
 
 #ifdef ENABLE_TRAINING
@@ -1575,6 +1590,9 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     std::unordered_set<std::string_view> inputs_and_initializers;
     std::unordered_map<std::string_view, NodeIndex> node_name_to_index;
     std::unordered_set<Node*> nodes_with_subgraphs;
+    // symbolic values of shape tensors (e.g. Shape -> Gather -> Concat) keyed by NodeArg name, in the form
+    // returned by InferenceContext::getSymbolicInput. see core/graph/symbolic_shape_inference.h.
+    std::unordered_map<std::string, ONNX_NAMESPACE::TensorShapeProto> symbolic_data;
 
     // check if the provided name is an input/initialize/node output of this Graph instance during Graph::Resolve.
     // Graph::node_args_ can have stale entries so we can't rely on that.
@@ -1589,6 +1607,7 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
       inputs_and_initializers.clear();
       node_name_to_index.clear();
       nodes_with_subgraphs.clear();
+      symbolic_data.clear();
     }
 
    private:
@@ -4,6 +4,7 @@
 #pragma once
 #include <unordered_set>
 #include <filesystem>
+#include <mutex>
 
 #include "core/graph/graph.h"
 #include "core/framework/session_options.h"
@@ -113,6 +114,9 @@ class GraphViewer {
 
   /** Gets the NodeIndex values for the Graph nodes, sorted into topological order.
   @remarks Filtered using filter_info_ if set.
+  The MEMORY_EFFICIENT order is computed on first use. Training builds order the nodes around the YieldOp, or use the
+  DEFAULT order for graphs without one. Other builds keep the size of the live tensors low, see
+  Graph::MemoryAwareTopologicalSort.
   */
   const std::vector<NodeIndex>& GetNodesInTopologicalOrder(ExecutionOrder order = ExecutionOrder::DEFAULT) const;
 
@@ -214,9 +218,12 @@ class GraphViewer {
   std::vector<NodeIndex> nodes_in_topological_order_with_priority_;
 #endif
 
-#ifdef ENABLE_TRAINING
+#if !defined(ORT_MINIMAL_BUILD)
   // The NodeIndex values of the graph nodes sorted in memory efficient topological order.
-  std::vector<NodeIndex> nodes_in_mem_efficient_topological_order_;
+  // Sorting needs the tensor sizes of the whole graph, so unless it comes from the training YieldOp order it is
+  // only computed if requested.
+  mutable std::once_flag mem_efficient_order_flag_;
+  mutable std::vector<NodeIndex> nodes_in_mem_efficient_topological_order_;
 #endif
 
   // Graph root nodes.
@@ -43,6 +43,13 @@ class GraphTransformer {
 
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Gets the op types of the nodes that make up the patterns this transformer matches.
+  After the first step, GraphTransformerManager only re-runs the transformer if a node of one of these op types
+  was changed, or is a neighbor of a node that was changed, since the transformer last ran.
+  An empty list means the transformer can match any node and is re-run on every step.
+  */
+  virtual InlinedVector<std::string_view> TargetOpTypes() const { return {}; }
+
  protected:
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
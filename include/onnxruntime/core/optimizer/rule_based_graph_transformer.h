@@ -53,6 +53,10 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   /** Returns the total number of rules that are registered in this transformer. */
   size_t RulesCount() const;
 
+  /** Returns the op types the registered rules are triggered on, or an empty list if any rule applies to all
+      op types. */
+  InlinedVector<std::string_view> TargetOpTypes() const override;
+
  protected:
   /** Applies the given set of rewrite rules on the Node of this Graph.
       @param[in] graph The Graph.
@@ -20,6 +20,14 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Use the intra-op thread pool during session initialization.
+// Currently this pre-packs the constant weights of different nodes concurrently. The inputs of one node are still
+// pre-packed in order.
+// Option values:
+// - "0": Session initialization runs on the calling thread. [DEFAULT]
+// - "1": Session initialization uses the intra-op thread pool.
+static const char* const kOrtSessionOptionsParallelInitialization = "session.parallel_initialization";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -67,6 +75,21 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the cost model of the NCHWc layout transformer. "0": disable; "1": enable. The default is "0".
+// When enabled, each connected region of NCHWc capable nodes is only converted if the estimated Conv savings exceed
+// the cost of reordering the tensors that enter and leave the region. Regions with unknown shapes are still converted.
+// The decision for each region is logged at the verbose level.
+static const char* const kOrtSessionOptionsNchwcLayoutCostModel = "optimization.nchwc_layout_cost_model";
+
+// Enable or disable fusing the encoder feed-forward block (MatMul, Gelu/FastGelu, MatMul, SkipLayerNormalization)
+// into an EncoderFeedForward node for the CPU EP. "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableEncoderFeedForwardFusion =
+    "optimization.enable_encoder_feed_forward_fusion";
+
+// Enable or disable fusing chains of element-wise operators into FusedElementwise nodes for the CPU EP.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableFusedElementwise = "optimization.enable_fused_elementwise";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -250,6 +273,18 @@ static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFil
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
 
+// Directory of a cache of optimized ONNX format models.
+// When set, the first session created for an ONNX format model saves the optimized graph in this directory, and
+// later sessions for the same model load it and skip the graph optimizations.
+// An entry is keyed by the model (the path, size and last write time of the model file and its external data files,
+// or a hash of the model bytes), the CPU architecture and ISA features and the NCHWc block size, the ORT version,
+// the execution providers of the session and their options, the graph optimization level, the disabled optimizers,
+// the free dimension overrides and the other session config entries. The key is stored in the entry and checked
+// when it is loaded. A cache directory may be shared by machines with different CPUs, as each gets its own entries.
+// Models that are loaded from a ModelProto or a stream, or that use session-provided external initializers,
+// are not cached. Entries are never removed by ORT.
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // When loading model from memory buffer and the model has external initializers
 // Use this config to set the external data file folder path
 // All external data files should be in the same folder
@@ -337,6 +372,15 @@ static const char* const kOrtSessionOptionsEpContextModelExternalInitializersFil
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Run the forward and reverse directions of bidirectional LSTM and GRU nodes on the CPU EP concurrently,
+// one direction per intra-op thread. Each direction then runs its per-step GEMMs and gate computations
+// single-threaded, so this pays off for models with many short, small steps where the per-step
+// parallelization overhead dominates.
+// Option values:
+// - "0": Directions are computed one after the other, each using the intra-op thread pool. [DEFAULT]
+// - "1": Directions are computed concurrently when the intra-op thread pool has at least 2 threads.
+static const char* const kOrtSessionOptionsRnnConcurrentBidirectional = "session.rnn_concurrent_bidirectional";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
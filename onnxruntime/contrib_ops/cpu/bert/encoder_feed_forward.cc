@@ -0,0 +1,252 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/encoder_feed_forward.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/safeint.h"
+#include "core/graph/contrib_ops/contrib_defs.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    EncoderFeedForward,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    EncoderFeedForward);
+
+namespace {
+
+// Keep the (tile_rows, intermediate_size) activation of a tile well within a typical per core L2 cache.
+constexpr size_t kActivationTileBytes = 256 * 1024;
+
+// FastGelu uses approximation for Gelu. The formula is 0.5 * (1 + Tanh(x * (C * x * x + B))) * x.
+constexpr float kFastGeluB = 0.7978845608028654f;    // sqrt(2.0 / M_PI)
+constexpr float kFastGeluC = 0.035677408136300125f;  // 0.044715 * sqrt(2.0 / M_PI)
+
+// In place data = Gelu(data + bias) for one row. temp has 'count' elements.
+void AddBiasGelu(float* data, const float* bias, float* temp, size_t count, bool use_approximation) {
+  if (use_approximation) {
+    for (size_t i = 0; i < count; i++) {
+      float value = data[i] + bias[i];
+      temp[i] = value * (kFastGeluC * value * value + kFastGeluB);
+      data[i] = value * 0.5f;
+    }
+
+    MlasComputeTanh(temp, temp, count);
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      float value = data[i] + bias[i];
+      temp[i] = value * static_cast<float>(M_SQRT1_2);
+      data[i] = value * 0.5f;
+    }
+
+    MlasComputeErf(temp, temp, count);
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    data[i] *= temp[i] + 1.0f;
+  }
+}
+
+// In place data = LayerNormalization(data + skip + bias) for one row. Same math as SkipLayerNormalization.
+void AddSkipLayerNorm(float* data, const float* skip, const float* gamma, const float* beta, const float* bias,
+                      size_t hidden_size, float epsilon) {
+  float mean = 0.0f;
+  float mean_square = 0.0f;
+  for (size_t h = 0; h < hidden_size; h++) {
+    float value = data[h] + skip[h];
+    if (bias != nullptr) {
+      value += bias[h];
+    }
+    data[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  mean_square = std::sqrt(mean_square / hidden_size - mean * mean + epsilon);
+
+  for (size_t h = 0; h < hidden_size; h++) {
+    data[h] = (data[h] - mean) / mean_square * gamma[h] + (beta != nullptr ? beta[h] : 0.0f);
+  }
+}
+
+Status CheckVector(const Tensor* tensor, int64_t size, const char* name) {
+  ORT_RETURN_IF_NOT(tensor->Shape().NumDimensions() == 1 && tensor->Shape()[0] == size,
+                    name, " is expected to have shape (", size, "), got ", tensor->Shape());
+  return Status::OK();
+}
+
+}  // namespace
+
+EncoderFeedForward::EncoderFeedForward(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttr<float>("epsilon", &epsilon_).IsOK());
+  ORT_ENFORCE(epsilon_ >= 0);
+
+  const std::string activation = info.GetAttrOrDefault<std::string>("activation", "Gelu");
+  ORT_ENFORCE(activation == "Gelu" || activation == "FastGelu", "Unsupported activation: ", activation);
+  use_approximation_ = activation == "FastGelu";
+}
+
+Status EncoderFeedForward::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  size_t packed_size = 0;
+  if (input_idx == kWeight1Index) {
+    is_packed = GemmPackBFp32(alloc, tensor, false, packed_weight1_, packed_size, weight1_shape_);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_weight1_));
+      prepacked_weights->buffer_sizes_.push_back(packed_size);
+    }
+  } else if (input_idx == kWeight2Index) {
+    is_packed = GemmPackBFp32(alloc, tensor, false, packed_weight2_, packed_size, weight2_shape_);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_weight2_));
+      prepacked_weights->buffer_sizes_.push_back(packed_size);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status EncoderFeedForward::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == kWeight1Index) {
+    used_shared_buffers = true;
+    packed_weight1_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == kWeight2Index) {
+    used_shared_buffers = true;
+    packed_weight2_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status EncoderFeedForward::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weight1 = packed_weight1_ ? nullptr : context->Input<Tensor>(kWeight1Index);
+  const Tensor* bias1 = context->Input<Tensor>(2);
+  const Tensor* weight2 = packed_weight2_ ? nullptr : context->Input<Tensor>(kWeight2Index);
+  const Tensor* gamma = context->Input<Tensor>(4);
+  const Tensor* beta = context->Input<Tensor>(5);
+  const Tensor* bias2 = context->Input<Tensor>(6);
+
+  const auto& input_shape = input->Shape();
+  const size_t input_rank = input_shape.NumDimensions();
+  ORT_RETURN_IF_NOT(input_rank == 2 || input_rank == 3,
+                    "input is expected to have 2 or 3 dimensions, got ", input_rank);
+
+  const int64_t hidden_size = input_shape[input_rank - 1];
+  const auto& weight1_shape = weight1 != nullptr ? weight1->Shape() : weight1_shape_;
+  ORT_RETURN_IF_NOT(weight1_shape.NumDimensions() == 2 && weight1_shape[0] == hidden_size,
+                    "weight1 is expected to have shape (hidden_size, intermediate_size), got ", weight1_shape);
+  const int64_t intermediate_size = weight1_shape[1];
+
+  const auto& weight2_shape = weight2 != nullptr ? weight2->Shape() : weight2_shape_;
+  ORT_RETURN_IF_NOT(weight2_shape.NumDimensions() == 2 && weight2_shape[0] == intermediate_size &&
+                        weight2_shape[1] == hidden_size,
+                    "weight2 is expected to have shape (intermediate_size, hidden_size), got ", weight2_shape);
+
+  ORT_RETURN_IF_ERROR(CheckVector(bias1, intermediate_size, "bias1"));
+  ORT_RETURN_IF_ERROR(CheckVector(gamma, hidden_size, "gamma"));
+  if (beta != nullptr) {
+    ORT_RETURN_IF_ERROR(CheckVector(beta, hidden_size, "beta"));
+  }
+  if (bias2 != nullptr) {
+    ORT_RETURN_IF_ERROR(CheckVector(bias2, hidden_size, "bias2"));
+  }
+
+  Tensor* output = context->Output(0, input_shape);
+  const int64_t rows = input_shape.SizeToDimension(input_rank - 1);
+  if (rows == 0 || hidden_size == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  const int64_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+
+  // Tiles are sized for the cache, but made smaller for short inputs so that every thread gets a tile.
+  int64_t tile_rows = std::max<int64_t>(
+      1, static_cast<int64_t>(kActivationTileBytes / (std::max<int64_t>(intermediate_size, 1) * sizeof(float))));
+  tile_rows = std::min(tile_rows, (rows + degree_of_parallelism - 1) / degree_of_parallelism);
+  const int64_t num_tiles = (rows + tile_rows - 1) / tile_rows;
+  const int64_t num_workers = std::min(num_tiles, degree_of_parallelism);
+
+  // each worker has a (tile_rows, intermediate_size) activation and one row of scratch for the activation function
+  const size_t worker_buffer_size = SafeInt<size_t>(tile_rows + 1) * intermediate_size;
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(num_workers) * worker_buffer_size);
+
+  const float* input_data = input->Data<float>();
+  const void* weight1_data = weight1 != nullptr ? weight1->DataRaw() : packed_weight1_.get();
+  const void* weight2_data = weight2 != nullptr ? weight2->DataRaw() : packed_weight2_.get();
+  const float* bias1_data = bias1->Data<float>();
+  const float* gamma_data = gamma->Data<float>();
+  const float* beta_data = beta != nullptr ? beta->Data<float>() : nullptr;
+  const float* bias2_data = bias2 != nullptr ? bias2->Data<float>() : nullptr;
+  float* output_data = output->MutableData<float>();
+
+  const size_t hidden = static_cast<size_t>(hidden_size);
+  const size_t intermediate = static_cast<size_t>(intermediate_size);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_workers, [&](std::ptrdiff_t worker) {
+    float* activation = buffer.get() + worker * worker_buffer_size;
+    float* temp = activation + static_cast<size_t>(tile_rows) * intermediate;
+
+    const auto work = concurrency::ThreadPool::PartitionWork(worker, num_workers, num_tiles);
+    for (std::ptrdiff_t tile = work.start; tile < work.end; tile++) {
+      const int64_t first_row = tile * tile_rows;
+      const size_t tile_size = static_cast<size_t>(std::min(tile_rows, rows - first_row));
+      const float* x = input_data + first_row * hidden_size;
+      float* y = output_data + first_row * hidden_size;
+
+      MLAS_SGEMM_DATA_PARAMS gemm1;
+      gemm1.A = x;
+      gemm1.lda = hidden;
+      gemm1.B = static_cast<const float*>(weight1_data);
+      gemm1.ldb = intermediate;
+      gemm1.BIsPacked = weight1 == nullptr;
+      gemm1.C = activation;
+      gemm1.ldc = intermediate;
+      MlasGemm(CblasNoTrans, CblasNoTrans, tile_size, intermediate, hidden, gemm1, nullptr);
+
+      for (size_t row = 0; row < tile_size; row++) {
+        AddBiasGelu(activation + row * intermediate, bias1_data, temp, intermediate, use_approximation_);
+      }
+
+      MLAS_SGEMM_DATA_PARAMS gemm2;
+      gemm2.A = activation;
+      gemm2.lda = intermediate;
+      gemm2.B = static_cast<const float*>(weight2_data);
+      gemm2.ldb = hidden;
+      gemm2.BIsPacked = weight2 == nullptr;
+      gemm2.C = y;
+      gemm2.ldc = hidden;
+      MlasGemm(CblasNoTrans, CblasNoTrans, tile_size, hidden, intermediate, gemm2, nullptr);
+
+      for (size_t row = 0; row < tile_size; row++) {
+        AddSkipLayerNorm(y + row * hidden, x + row * hidden, gamma_data, beta_data, bias2_data, hidden, epsilon_);
+      }
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LayerNormalization(input + Activation(input * weight1 + bias1) * weight2 + bias2).
+// The rows of the input are split in tiles and each tile runs the whole block on one thread, so the intermediate
+// activation of a tile is produced and consumed while it is still in cache.
+class EncoderFeedForward final : public OpKernel {
+ public:
+  EncoderFeedForward(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  static constexpr int kWeight1Index = 1;
+  static constexpr int kWeight2Index = 3;
+
+  float epsilon_;
+  bool use_approximation_;
+
+  // packed weight1 and weight2
+  IAllocatorUniquePtr<void> packed_weight1_;
+  IAllocatorUniquePtr<void> packed_weight2_;
+  TensorShape weight1_shape_;
+  TensorShape weight2_shape_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embedding_bag.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/float16.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                  \
+      EmbeddingBag,                                                               \
+      kMSDomain,                                                                  \
+      1,                                                                          \
+      T,                                                                          \
+      kCpuExecutionProvider,                                                      \
+      KernelDefBuilder()                                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                  \
+          .TypeConstraint("Tind", BuildKernelDefConstraints<int32_t, int64_t>()), \
+      EmbeddingBag<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+inline float ToFloat(float value) { return value; }
+inline float ToFloat(MLFloat16 value) { return value.ToFloat(); }
+
+// Accumulates the rows indices[begin, end) of the table into `accumulator`, which holds embedding_dim floats.
+template <typename T, typename Tind>
+void PoolBag(const T* table, int64_t num_embeddings, size_t embedding_dim, const Tind* indices, const T* weights,
+             int64_t begin, int64_t end, bool mean, float* accumulator) {
+  std::fill_n(accumulator, embedding_dim, 0.0f);
+
+  for (int64_t i = begin; i < end; ++i) {
+    int64_t idx = static_cast<int64_t>(indices[i]);
+    idx = idx < 0 ? idx + num_embeddings : idx;
+    const T* row = table + static_cast<size_t>(idx) * embedding_dim;
+    if (weights != nullptr) {
+      const float weight = ToFloat(weights[i]);
+      for (size_t j = 0; j < embedding_dim; ++j) {
+        accumulator[j] += weight * ToFloat(row[j]);
+      }
+    } else {
+      for (size_t j = 0; j < embedding_dim; ++j) {
+        accumulator[j] += ToFloat(row[j]);
+      }
+    }
+  }
+
+  if (mean && end > begin) {
+    const float scale = 1.0f / static_cast<float>(end - begin);
+    for (size_t j = 0; j < embedding_dim; ++j) {
+      accumulator[j] *= scale;
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status EmbeddingBag<T>::Compute(OpKernelContext* context) const {
+  const Tensor* indices = context->Input<Tensor>(1);
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename T>
+template <typename Tind>
+Status EmbeddingBag<T>::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* data = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+  const Tensor* per_sample_weights = context->Input<Tensor>(3);
+
+  const TensorShape& data_shape = data->Shape();
+  ORT_RETURN_IF_NOT(data_shape.NumDimensions() == 2, "data must be 2-D. Got: ", data_shape);
+  const int64_t num_embeddings = data_shape[0];
+  const int64_t embedding_dim = data_shape[1];
+
+  const TensorShape& indices_shape = indices->Shape();
+  const int64_t num_indices = indices_shape.Size();
+  const Tind* indices_data = indices->Data<Tind>();
+
+  TensorShapeVector output_dims;
+  int64_t num_bags = 0;
+  int64_t bag_size = 0;
+  const Tind* offsets_data = nullptr;
+
+  if (offsets != nullptr) {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 1,
+                      "indices must be 1-D when offsets is provided. Got: ", indices_shape);
+    ORT_RETURN_IF_NOT(offsets->Shape().NumDimensions() == 1, "offsets must be 1-D. Got: ", offsets->Shape());
+    num_bags = offsets->Shape()[0];
+    offsets_data = offsets->Data<Tind>();
+    int64_t previous = 0;
+    for (int64_t i = 0; i < num_bags; ++i) {
+      const int64_t offset = static_cast<int64_t>(offsets_data[i]);
+      ORT_RETURN_IF_NOT(offset >= previous && offset <= num_indices,
+                        "offsets must be non-decreasing and within [0, ", num_indices, "]. Got offsets[", i,
+                        "]=", offset);
+      previous = offset;
+    }
+    output_dims = {num_bags, embedding_dim};
+  } else {
+    const size_t rank = indices_shape.NumDimensions();
+    ORT_RETURN_IF_NOT(rank >= 1, "indices must have rank >= 1 when offsets is not provided.");
+    bag_size = indices_shape[rank - 1];
+    num_bags = indices_shape.SizeToDimension(rank - 1);
+    output_dims.assign(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+    output_dims.push_back(embedding_dim);
+  }
+
+  const T* weights_data = nullptr;
+  if (per_sample_weights != nullptr) {
+    ORT_RETURN_IF_NOT(per_sample_weights->Shape().Size() == num_indices,
+                      "per_sample_weights must have as many elements as indices. Got: ",
+                      per_sample_weights->Shape(), " for indices of shape ", indices_shape);
+    weights_data = per_sample_weights->Data<T>();
+  }
+
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -num_embeddings || idx >= num_embeddings) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_embeddings, ",", num_embeddings - 1, "]");
+    }
+  }
+
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  if (num_bags == 0 || embedding_dim == 0) {
+    return Status::OK();
+  }
+
+  const T* table = data->Data<T>();
+  T* output_data = output->MutableData<T>();
+  const size_t dim = narrow<size_t>(embedding_dim);
+  const bool mean = mean_;
+
+  // Each bag reads its rows once and writes one output row, so the cost is the number of table elements touched.
+  const int64_t average_bag_size = std::max<int64_t>(num_indices / num_bags, 1);
+  const double cost = static_cast<double>(SafeInt<int64_t>(average_bag_size) * embedding_dim);
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_bags), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> accumulator_buffer;
+        if constexpr (!std::is_same_v<T, float>) {
+          accumulator_buffer.resize(dim);
+        }
+
+        for (std::ptrdiff_t bag = first; bag < last; ++bag) {
+          int64_t begin;
+          int64_t end;
+          if (offsets_data != nullptr) {
+            begin = static_cast<int64_t>(offsets_data[bag]);
+            end = bag + 1 < num_bags ? static_cast<int64_t>(offsets_data[bag + 1]) : num_indices;
+          } else {
+            begin = bag * bag_size;
+            end = begin + bag_size;
+          }
+
+          T* output_row = output_data + bag * dim;
+          if constexpr (std::is_same_v<T, float>) {
+            PoolBag(table, num_embeddings, dim, indices_data, weights_data, begin, end, mean, output_row);
+          } else {
+            PoolBag(table, num_embeddings, dim, indices_data, weights_data, begin, end, mean,
+                    accumulator_buffer.data());
+            for (size_t j = 0; j < dim; ++j) {
+              output_row[j] = T(accumulator_buffer[j]);
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
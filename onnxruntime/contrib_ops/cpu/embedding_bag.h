@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Pools rows of an embedding table per bag (Gather followed by ReduceSum/ReduceMean) without materializing the
+// gathered [num_indices, embedding_dim] intermediate.
+template <typename T>
+class EmbeddingBag final : public OpKernel {
+ public:
+  EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be 'sum' or 'mean'. Got: ", mode);
+    mean_ = mode == "mean";
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  bool mean_{false};
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,271 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/graph/contrib_ops/contrib_defs.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<bool>()})
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of output elements each step processes at a time. The registers of a chunk fit in L1.
+constexpr int64_t kChunkSize = 256;
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  num_inputs_ = info.GetInputCount();
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(), "ops must have at least one entry");
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK() && operands.size() == ops.size() * 3,
+              "operands must have 3 entries per op");
+
+  static const InlinedHashMap<std::string, std::pair<OpCode, int>> op_codes{
+      {"Add", {OpCode::Add, 2}},
+      {"Sub", {OpCode::Sub, 2}},
+      {"Mul", {OpCode::Mul, 2}},
+      {"Div", {OpCode::Div, 2}},
+      {"Sqrt", {OpCode::Sqrt, 1}},
+      {"Erf", {OpCode::Erf, 1}},
+      {"Tanh", {OpCode::Tanh, 1}},
+      {"Where", {OpCode::Where, 3}},
+  };
+
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto it = op_codes.find(ops[i]);
+    ORT_ENFORCE(it != op_codes.end(), "Unsupported op in FusedElementwise: ", ops[i]);
+
+    Step step;
+    step.op = it->second.first;
+    const int arity = it->second.second;
+    for (int j = 0; j < 3; ++j) {
+      const int64_t operand = operands[i * 3 + j];
+      if (j < arity) {
+        // a step can only use the inputs and the results of the steps before it
+        ORT_ENFORCE(operand >= 0 && static_cast<size_t>(operand) < num_inputs_ + i,
+                    "Invalid operand ", operand, " for step ", i, " (", ops[i], ")");
+      } else {
+        ORT_ENFORCE(operand == -1, "Unused operand of step ", i, " (", ops[i], ") must be -1");
+      }
+      step.operands[j] = static_cast<int>(operand);
+    }
+    steps_.push_back(step);
+  }
+}
+
+void FusedElementwise::RunStep(const Step& step, const float* const* registers, float* output, size_t count) const {
+  const float* a = registers[step.operands[0]];
+  const float* b = step.operands[1] >= 0 ? registers[step.operands[1]] : nullptr;
+  const float* c = step.operands[2] >= 0 ? registers[step.operands[2]] : nullptr;
+
+  switch (step.op) {
+    case OpCode::Add:
+      MlasEltwiseAdd<float>(a, b, output, count);
+      break;
+    case OpCode::Sub:
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = a[i] - b[i];
+      }
+      break;
+    case OpCode::Mul:
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = a[i] * b[i];
+      }
+      break;
+    case OpCode::Div:
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = a[i] / b[i];
+      }
+      break;
+    case OpCode::Sqrt:
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = std::sqrt(a[i]);
+      }
+      break;
+    case OpCode::Erf:
+      MlasComputeErf(a, output, count);
+      break;
+    case OpCode::Tanh:
+      MlasComputeTanh(a, output, count);
+      break;
+    case OpCode::Where:
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = a[i] != 0.0f ? b[i] : c[i];
+      }
+      break;
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  InlinedVector<const Tensor*> inputs(num_inputs_);
+  size_t rank = 0;
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    inputs[i] = context->Input<Tensor>(static_cast<int>(i));
+    rank = std::max(rank, inputs[i]->Shape().NumDimensions());
+  }
+
+  // multidirectional broadcast of all the inputs
+  TensorShapeVector output_dims(rank, 1);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    const auto& input_shape = inputs[i]->Shape();
+    const size_t offset = rank - input_shape.NumDimensions();
+    for (size_t d = 0; d < input_shape.NumDimensions(); ++d) {
+      const int64_t dim = input_shape[d];
+      int64_t& output_dim = output_dims[offset + d];
+      if (output_dim == 1) {
+        output_dim = dim;
+      } else {
+        ORT_RETURN_IF_NOT(dim == output_dim || dim == 1, "FusedElementwise: input ", i, " with shape ", input_shape,
+                          " can not be broadcast to ", TensorShape(output_dims));
+      }
+    }
+  }
+
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  const int64_t total = output->Shape().Size();
+  if (total == 0) {
+    return Status::OK();
+  }
+
+  // Strides of each input over the output dimensions, with 0 for a broadcast dimension. Dimensions of size 1 are
+  // dropped and adjacent dimensions that are contiguous in every input are merged, so that the inner dimension is
+  // as long as possible.
+  InlinedVector<int64_t> dims;
+  for (size_t d = 0; d < rank; ++d) {
+    if (output_dims[d] != 1) {
+      dims.push_back(output_dims[d]);
+    }
+  }
+
+  std::vector<InlinedVector<int64_t>> strides(num_inputs_);
+  InlinedVector<int64_t> input_strides(rank);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    const auto& input_shape = inputs[i]->Shape();
+    const size_t offset = rank - input_shape.NumDimensions();
+    int64_t stride = 1;
+    for (size_t d = rank; d-- > 0;) {
+      const int64_t dim = d >= offset ? input_shape[d - offset] : 1;
+      input_strides[d] = dim == 1 ? 0 : stride;
+      stride *= dim;
+    }
+
+    for (size_t d = 0; d < rank; ++d) {
+      if (output_dims[d] != 1) {
+        strides[i].push_back(input_strides[d]);
+      }
+    }
+  }
+
+  InlinedVector<int64_t> coalesced_dims;
+  std::vector<InlinedVector<int64_t>> coalesced_strides(num_inputs_);
+  for (size_t d = 0; d < dims.size(); ++d) {
+    bool contiguous = !coalesced_dims.empty();
+    for (size_t i = 0; contiguous && i < num_inputs_; ++i) {
+      contiguous = coalesced_strides[i].back() == strides[i][d] * dims[d];
+    }
+    if (contiguous) {
+      coalesced_dims.back() *= dims[d];
+      for (size_t i = 0; i < num_inputs_; ++i) {
+        coalesced_strides[i].back() = strides[i][d];
+      }
+    } else {
+      coalesced_dims.push_back(dims[d]);
+      for (size_t i = 0; i < num_inputs_; ++i) {
+        coalesced_strides[i].push_back(strides[i][d]);
+      }
+    }
+  }
+  if (coalesced_dims.empty()) {
+    coalesced_dims.push_back(1);
+    for (size_t i = 0; i < num_inputs_; ++i) {
+      coalesced_strides[i].push_back(0);
+    }
+  }
+
+  const size_t outer_rank = coalesced_dims.size() - 1;
+  const int64_t inner_size = coalesced_dims.back();
+  const int64_t chunks_per_row = (inner_size + kChunkSize - 1) / kChunkSize;
+  const int64_t num_blocks = (total / inner_size) * chunks_per_row;
+
+  InlinedVector<bool> is_bool(num_inputs_);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    is_bool[i] = inputs[i]->IsDataType<bool>();
+  }
+  float* output_data = output->MutableData<float>();
+  const size_t num_registers = num_inputs_ + steps_.size();
+
+  const TensorOpCost cost{static_cast<double>(num_inputs_ * kChunkSize * sizeof(float)),
+                          static_cast<double>(kChunkSize * sizeof(float)),
+                          static_cast<double>(steps_.size() * kChunkSize)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_blocks, cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> scratch(num_registers * kChunkSize);
+        InlinedVector<const float*> registers(num_registers);
+
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t row = block / chunks_per_row;
+          const int64_t start = (block % chunks_per_row) * kChunkSize;
+          const size_t count = static_cast<size_t>(std::min(kChunkSize, inner_size - start));
+
+          for (size_t i = 0; i < num_inputs_; ++i) {
+            const auto& input_strides = coalesced_strides[i];
+            int64_t offset = 0;
+            int64_t remaining = row;
+            for (size_t d = outer_rank; d-- > 0;) {
+              offset += (remaining % coalesced_dims[d]) * input_strides[d];
+              remaining /= coalesced_dims[d];
+            }
+
+            const bool is_broadcast = input_strides[outer_rank] == 0;
+            float* input_scratch = scratch.data() + i * kChunkSize;
+            if (is_bool[i]) {
+              const bool* data = inputs[i]->Data<bool>() + offset;
+              for (size_t k = 0; k < count; ++k) {
+                input_scratch[k] = (is_broadcast ? data[0] : data[start + k]) ? 1.0f : 0.0f;
+              }
+              registers[i] = input_scratch;
+            } else if (is_broadcast) {
+              std::fill_n(input_scratch, count, inputs[i]->Data<float>()[offset]);
+              registers[i] = input_scratch;
+            } else {
+              registers[i] = inputs[i]->Data<float>() + offset + start;
+            }
+          }
+
+          for (size_t s = 0; s < steps_.size(); ++s) {
+            float* step_output = s + 1 == steps_.size()
+                                     ? output_data + row * inner_size + start
+                                     : scratch.data() + (num_inputs_ + s) * kChunkSize;
+            RunStep(steps_[s], registers.data(), step_output, count);
+            registers[num_inputs_ + s] = step_output;
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Evaluates a chain of element-wise operators produced by FusedElementwiseFusion.
+// The output is processed in chunks of a few hundred elements. Every step of the chain runs on the chunk before
+// moving on, so the intermediate results stay in L1 and each input is read once.
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class OpCode {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Sqrt,
+    Erf,
+    Tanh,
+    Where,
+  };
+
+  struct Step {
+    OpCode op;
+    int operands[3];
+  };
+
+  void RunStep(const Step& step, const float* const* registers, float* output, size_t count) const;
+
+  InlinedVector<Step> steps_;
+  size_t num_inputs_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
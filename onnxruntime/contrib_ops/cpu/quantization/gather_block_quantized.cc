@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
@@ -18,17 +20,58 @@ namespace contrib {
 
 namespace {
 template <typename T1>
-int32_t GetDataElement(const T1* data_ptr, int64_t data_idx) {
+int32_t GetDataElement(const T1* data_ptr, int64_t data_idx, int64_t /*bits*/) {
   return static_cast<int32_t>(data_ptr[data_idx >> 1].GetElem(narrow<size_t>(data_idx & 1)));
 }
 
 template <>
-int32_t GetDataElement<uint8_t>(const uint8_t* data_ptr, int64_t data_idx) {
+int32_t GetDataElement<uint8_t>(const uint8_t* data_ptr, int64_t data_idx, int64_t bits) {
+  if (bits == 8) {
+    return static_cast<int32_t>(data_ptr[data_idx]);
+  }
+
   const uint8_t data_val_u8 = data_ptr[data_idx >> 1];
   // Weights are stored as (nibble2)(nibble1) in uint8_t.
   auto data_val = static_cast<int32_t>((data_idx & 1) ? ((data_val_u8 >> 4) & 0x0F) : (data_val_u8 & 0x0F));
   return data_val;
 }
+
+template <typename T1>
+int32_t GetZeroPoint(const T1* zero_points_ptr, int64_t scale_idx, int64_t /*bits*/) {
+  return static_cast<int32_t>(zero_points_ptr ? zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1))
+                                              : 0);
+}
+
+template <>
+int32_t GetZeroPoint<uint8_t>(const uint8_t* zero_points_ptr, int64_t scale_idx, int64_t bits) {
+  if (bits == 8) {
+    return zero_points_ptr ? static_cast<int32_t>(zero_points_ptr[scale_idx]) : 128;
+  }
+  // The default zero point for uint8 weights as stored by MatMulNBits op is 8.
+  return 8;
+}
+
+// Dequantizes `count` consecutive elements starting at data_idx that share one scale and zero point.
+template <typename T1, typename T2>
+void DequantizeRun(const T1* data_ptr, int64_t data_idx, int64_t count, float scale, int32_t zero_point,
+                   int64_t bits, T2* output_ptr) {
+  if constexpr (std::is_same_v<T1, uint8_t>) {
+    if (bits == 8) {
+      // Plain loop over bytes so the compiler can vectorize the conversion.
+      const uint8_t* src = data_ptr + data_idx;
+      const float zp = static_cast<float>(zero_point);
+      for (int64_t i = 0; i < count; ++i) {
+        output_ptr[i] = static_cast<T2>((static_cast<float>(src[i]) - zp) * scale);
+      }
+      return;
+    }
+  }
+
+  for (int64_t i = 0; i < count; ++i) {
+    auto data_val = GetDataElement(data_ptr, data_idx + i, bits);
+    output_ptr[i] = static_cast<T2>(static_cast<float>(data_val - zero_point) * scale);
+  }
+}
 }  // namespace
 
 template <typename T1, typename Tind>
@@ -47,8 +90,12 @@ class GatherBlockQuantized : public OpKernel {
       block_size_ = 128;
     }
 
+    bits_ = info.GetAttrOrDefault<int64_t>("bits", 4);
+
     ORT_ENFORCE(block_size_ >= 16 && ((block_size_ - 1) & block_size_) == 0,
                 "'block_size' must be 2's power and not less than 16.");
+    ORT_ENFORCE(bits_ == 4 || (bits_ == 8 && std::is_same_v<T1, uint8_t>),
+                "'bits' must be 4, or 8 for uint8 data. Got: ", bits_);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -78,12 +125,19 @@ class GatherBlockQuantized : public OpKernel {
                                const int64_t gather_block,
                                const int64_t quantize_axis_dim,
                                const int64_t quantize_N,
+                               const bool whole_rows,
                                concurrency::ThreadPool* tp) const;
 
+  // Number of quantized elements stored in one T1 element of data.
+  int64_t Components() const {
+    return std::is_same_v<T1, uint8_t> && bits_ == 4 ? 2 : 1;
+  }
+
  private:
   int64_t gather_axis_;
   int64_t quantize_axis_;
   int64_t block_size_;
+  int64_t bits_;
 };
 
 template <typename T1, typename Tind>
@@ -117,7 +171,7 @@ Status GatherBlockQuantized<T1, Tind>::PrepareForCompute(OpKernelContext* contex
   // The shape in the onnx model reflects that by having the last dimension be half the number of values.
   // Ex: For a true data size of 2000x3072, the onnx model would have data of shape 2000x1536.
   // However the outputs still need to be of size 2000x3072. Therefore we x2 the last dimension here.
-  uint32_t components = (std::is_same_v<T1, uint8_t>) ? 2 : 1;
+  const int64_t components = Components();
   shape[shape.size() - 1] = shape.back() * components;
   p.output_tensor = context->Output(0, TensorShape(std::move(shape)));
 
@@ -158,10 +212,12 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
                                                              const int64_t gather_block,
                                                              const int64_t quantize_axis_dim,
                                                              const int64_t quantize_N,
+                                                             const bool whole_rows,
                                                              concurrency::ThreadPool* tp) const {
   auto data_full_block = gather_axis_dim * gather_block;
   auto quantize_full_block = quantize_axis_dim * quantize_N;
   auto scale_full_block = (quantize_axis_dim + block_size_ - 1) / block_size_ * quantize_N;
+  const int64_t bits = bits_;
 
   auto lambda = [&](int64_t gather_MN_idx, std::unordered_map<int64_t, int64_t>& cache) {
     int64_t gather_M_idx = gather_MN_idx / gather_N;
@@ -182,28 +238,35 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       return;
     }
 
-    // TODO(fajin): use SIMD
-    int64_t output_idx = output_idx_base;
-    int64_t data_idx = data_idx_base;
-    for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
-      auto data_val = GetDataElement(data_ptr, data_idx);
-
-      int64_t x = data_idx / quantize_full_block;
-      int64_t y = data_idx % quantize_full_block / quantize_N;
-      int64_t z = data_idx % quantize_N;
-      int64_t scale_idx = x * scale_full_block + y / block_size_ * quantize_N + z;
-      auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
-      int32_t zp_val;
-      if constexpr (std::is_same_v<T1, uint8_t>) {
-        // The default zero point for uint8 weights as stored by MatMulNBits op is 8.
-        zp_val = 8;
-      } else {
-        zp_val = static_cast<int32_t>(zero_points_ptr
-                                          ? zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1))
-                                          : 0);
+    if (whole_rows) {
+      // The gathered block is made of whole rows along the innermost quantize axis, so each run of block_size_
+      // elements shares one scale and zero point. Look them up once per run instead of once per element.
+      for (int64_t row_offset = 0; row_offset < gather_block; row_offset += quantize_axis_dim) {
+        const int64_t data_row_idx = data_idx_base + row_offset;
+        const int64_t scale_row_idx = data_row_idx / quantize_axis_dim * scale_full_block;
+        T2* output_row = output_ptr + output_idx_base + row_offset;
+        for (int64_t begin = 0; begin < quantize_axis_dim; begin += block_size_) {
+          const int64_t scale_idx = scale_row_idx + begin / block_size_;
+          const int64_t count = std::min(block_size_, quantize_axis_dim - begin);
+          DequantizeRun(data_ptr, data_row_idx + begin, count, static_cast<float>(scales_ptr[scale_idx]),
+                        GetZeroPoint(zero_points_ptr, scale_idx, bits), bits, output_row + begin);
+        }
+      }
+    } else {
+      int64_t output_idx = output_idx_base;
+      int64_t data_idx = data_idx_base;
+      for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
+        auto data_val = GetDataElement(data_ptr, data_idx, bits);
+
+        int64_t x = data_idx / quantize_full_block;
+        int64_t y = data_idx % quantize_full_block / quantize_N;
+        int64_t z = data_idx % quantize_N;
+        int64_t scale_idx = x * scale_full_block + y / block_size_ * quantize_N + z;
+        auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
+        int32_t zp_val = GetZeroPoint(zero_points_ptr, scale_idx, bits);
+
+        output_ptr[output_idx] = static_cast<T2>(static_cast<float>(data_val - zp_val) * scale_val);
       }
-
-      output_ptr[output_idx] = static_cast<T2>(static_cast<float>(data_val - zp_val) * scale_val);
     }
 
     cache[data_idx_base] = output_idx_base;
@@ -232,7 +295,7 @@ template <typename T1, typename Tind>
 Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute(context, p));
-  auto components = (std::is_same_v<T1, uint8_t>) ? 2 : 1;
+  const int64_t components = Components();
   const auto& data_shape = p.data_tensor->Shape();
   // re-shape the data tensor to [gather_M, gather_axis_dim, gather_block]
   // re-shape the indices tensor to [gather_N]
@@ -258,6 +321,8 @@ Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
   //  4> get scale index: (x, y / block_size_, z)
   const int64_t quantize_axis_dim = data_shape[narrow<size_t>(p.quantize_axis)] * components;
   const int64_t quantize_N = data_shape.SizeFromDimension(SafeInt<size_t>(p.quantize_axis) + 1);
+  // e.g. an embedding table [vocab, hidden] gathered on axis 0 and quantized along the hidden axis.
+  const bool whole_rows = quantize_N == 1 && p.gather_axis < p.quantize_axis;
 
   concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   const auto* data_ptr = p.data_tensor->template Data<T1>();
@@ -271,7 +336,7 @@ Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
 
     return CopyDataAndDequantize<float>(data_ptr, indices_ptr, scales_ptr, zero_points_ptr,
                                         output_ptr, gather_M, gather_N, gather_axis_dim, gather_block,
-                                        quantize_axis_dim, quantize_N,
+                                        quantize_axis_dim, quantize_N, whole_rows,
                                         tp);
   } else if (dequantized_type == ONNX_NAMESPACE::TensorProto::FLOAT16) {
     const auto* scales_ptr = p.scales_tensor->template Data<MLFloat16>();
@@ -279,7 +344,7 @@ Status GatherBlockQuantized<T1, Tind>::Compute(OpKernelContext* context) const {
 
     return CopyDataAndDequantize<MLFloat16>(data_ptr, indices_ptr, scales_ptr, zero_points_ptr,
                                             output_ptr, gather_M, gather_N, gather_axis_dim, gather_block,
-                                            quantize_axis_dim, quantize_N,
+                                            quantize_axis_dim, quantize_N, whole_rows,
                                             tp);
   } else if (dequantized_type == ONNX_NAMESPACE::TensorProto::BFLOAT16) {
     ORT_THROW("DequantizeLinear into BFLOAT16 is not implemented yet.");
@@ -8,6 +8,7 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 #include "re2/re2.h"
 
 #ifdef _MSC_VER
@@ -15,6 +16,7 @@
 #define ORT_PMR_ALLOCATOR_SUPPORTED
 #endif
 
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -52,7 +54,11 @@ class Tokenizer final : public OpKernel {
                          size_t N, size_t C,
                          gsl::span<const int64_t> input_dims) const;
 
-  void OutputData(gsl::span<const SlicesVector> rows,
+  Status TokenizeWithSeparators(const std::string& s, SlicesVector& row, SlicesVector& tokens) const;
+
+  Status TokenizeWithExpression(const std::string& s, SlicesVector& row) const;
+
+  void OutputData(concurrency::ThreadPool* tp, gsl::span<const SlicesVector> rows,
                   size_t max_tokens, size_t max_output_index, std::string* output_data) const;
 
   bool mark_{false};
@@ -76,6 +82,27 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 constexpr char kStartMarker = 0x2;
 constexpr char kEndMarker = 0x3;
+
+// Runs process_rows(first, last) over [0, num_rows) splitting the rows across the thread pool,
+// and returns the first error encountered.
+template <typename ProcessRows>
+Status ParallelForRows(concurrency::ThreadPool* tp, size_t num_rows, double cost_per_row,
+                       ProcessRows&& process_rows) {
+  std::mutex mutex;
+  Status status;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_rows), cost_per_row,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        Status rows_status = process_rows(static_cast<size_t>(first), static_cast<size_t>(last));
+        if (!rows_status.IsOK()) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (status.IsOK()) {
+            status = std::move(rows_status);
+          }
+        }
+      });
+  return status;
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -167,19 +194,23 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   size_t max_tokens = 0;
   auto X = ctx->Input<Tensor>(0);
   auto const input_data = X->Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
+  const size_t num_rows = N * C;
+
+  // ASCII strings have one token per byte and need no utf8 decoding
+  InlinedVector<bool> is_ascii(num_rows);
+  for (size_t row = 0; row < num_rows; ++row) {
+    const auto& s = input_data[row];
     size_t tokens = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       tokens)) {
+    is_ascii[row] = utf8_util::is_ascii(s.data(), s.size());
+    if (is_ascii[row]) {
+      tokens = s.size();
+    } else if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                              tokens)) {
       // Please do not include the input text in the error message as it could
       // be deemed as a compliance violation by teams using this operator
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input string contains invalid utf8 chars:", s);
     }
     max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
   }
 
   TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
@@ -199,40 +230,51 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   TensorShape output_shape(output_dims);
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      output_data[output_index].assign(&kStartMarker, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      assert(token_idx + tlen <= str_len);
-      output_data[output_index] = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      output_data[output_index].assign(&kEndMarker, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      output_data[output_index] = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
-  }
-  return Status::OK();
+
+  // Every row fills exactly max_tokens output strings, so rows are written independently
+  return ParallelForRows(
+      ctx->GetOperatorThreadPool(), num_rows, static_cast<double>(max_tokens) * 16.0,
+      [&](size_t first_row, size_t last_row) {
+        for (size_t row = first_row; row < last_row; ++row) {
+          const auto& s = input_data[row];
+          size_t output_index = row * max_tokens;
+          if (mark_) {
+            output_data[output_index].assign(&kStartMarker, 1);
+            ++output_index;
+          }
+          size_t tokens = 0;
+          const size_t str_len = s.size();
+          if (is_ascii[row]) {
+            for (; tokens < str_len; ++tokens) {
+              output_data[output_index].assign(1, s[tokens]);
+              ++output_index;
+            }
+          } else {
+            for (size_t token_idx = 0; token_idx < str_len;) {
+              size_t tlen = 0;
+              [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+              assert(result);
+              assert(token_idx + tlen <= str_len);
+              output_data[output_index].assign(s, token_idx, tlen);
+              ++output_index;
+              token_idx += tlen;
+              ++tokens;
+            }
+          }
+          if (mark_) {
+            output_data[output_index].assign(&kEndMarker, 1);
+            ++output_index;
+          }
+          // Padding strings
+          assert(tokens + (static_cast<size_t>(mark_) * 2) <= max_tokens);
+          const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - tokens;
+          for (size_t p = 0; p < pads; ++p) {
+            output_data[output_index] = pad_value_;
+            ++output_index;
+          }
+        }
+        return Status::OK();
+      });
 }
 
 namespace {
@@ -314,37 +356,135 @@ class MemoryAllocator {
 };
 
 #endif
+
+// Thread pool used to tokenize rows concurrently.
+concurrency::ThreadPool* RowsThreadPool(OpKernelContext* ctx) {
+#ifdef ORT_PMR_ALLOCATOR_SUPPORTED
+  // All rows allocate from the same monotonic buffer resource, which is not thread-safe
+  ORT_UNUSED_PARAMETER(ctx);
+  return nullptr;
+#else
+  return ctx->GetOperatorThreadPool();
+#endif
+}
 }  // namespace
 
-void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
+void Tokenizer::OutputData(concurrency::ThreadPool* tp, gsl::span<const SlicesVector> rows,
                            size_t max_tokens, [[maybe_unused]] size_t max_output_index, std::string* output_data) const {
-  size_t output_index = 0;
-  for (const auto& row : rows) {
-    [[maybe_unused]] size_t c_idx = output_index;
-    if (mark_) {
-      output_data[output_index++].assign(&kStartMarker, 1);
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      output_data[output_index++].assign(token.data(), token.length());
-    }
-    if (mark_) {
-      output_data[output_index++].assign(&kEndMarker, 1);
-    }
-    const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      output_data[output_index++] = pad_value_;
-    }
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
+  // Every row fills exactly max_tokens output strings, so rows are written independently
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(rows.size()), static_cast<double>(max_tokens) * 16.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto r = static_cast<size_t>(first), end = static_cast<size_t>(last); r < end; ++r) {
+          const auto& row = rows[r];
+          size_t output_index = r * max_tokens;
+          [[maybe_unused]] size_t c_idx = output_index;
+          if (mark_) {
+            output_data[output_index++].assign(&kStartMarker, 1);
+          }
+          // Output tokens for this row
+          for (const auto& token : row) {
+            output_data[output_index++].assign(token.data(), token.length());
+          }
+          if (mark_) {
+            output_data[output_index++].assign(&kEndMarker, 1);
+          }
+          const size_t pads = max_tokens - (static_cast<size_t>(mark_) * 2) - row.size();
+          for (size_t p = 0; p < pads; ++p) {
+            output_data[output_index++] = pad_value_;
+          }
+          assert(output_index <= max_output_index);
+          assert((output_index - c_idx) <= max_tokens);
+        }
+      });
+}
+
+Status Tokenizer::TokenizeWithSeparators(const std::string& s, SlicesVector& row, SlicesVector& tokens) const {
+  using namespace re2;
+
+  // We do not constraint the search to match
+  // on the beginning or end of the string
+  constexpr RE2::Anchor anchor = RE2::UNANCHORED;
+
+  size_t utf8_chars = 0;  // length in utf8 chars
+  if (!utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
   }
+
+  const auto expected_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
+  row.reserve(expected_tokens);
+  row.emplace_back(s);
+
+  for (const auto& sep : separators_) {
+    for (const auto& text : row) {
+      const auto end_pos = text.length();
+      size_t start_pos = 0;
+      StringPiece submatch;
+
+      bool match = true;
+      do {
+        match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+        if (match) {
+          // Record  pos/len
+          assert(submatch.data() != nullptr);
+          size_t match_pos = submatch.data() - text.data();
+          assert(match_pos >= start_pos);
+          auto token_len = match_pos - start_pos;
+          utf8_chars = 0;
+          bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                                token_len, utf8_chars);
+          if (!valid) {
+            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                          "Match contains invalid utf8 chars: " + std::string{submatch});
+          }
+          if (utf8_chars >= mincharnum_) {
+            tokens.emplace_back(text.data() + start_pos, token_len);
+          }
+          // Update starting position
+          // Guard against empty string match
+          auto match_len = submatch.length();
+          if (match_len > 0) {
+            start_pos = match_pos + match_len;
+          } else {
+            size_t bytes = 0;
+            utf8_bytes(*submatch.data(), bytes);
+            start_pos = match_pos + bytes;
+          }
+        } else {
+          // record trailing token
+          auto trailing_len = end_pos - start_pos;
+          utf8_chars = 0;
+          utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                   trailing_len, utf8_chars);
+          if (utf8_chars >= mincharnum_) {
+            tokens.emplace_back(text.data() + start_pos, trailing_len);
+          }
+        }
+      } while (match);
+    }  // row
+
+    // We want to preserve the buffer for the next separator
+    // copying slices is cheaper than allocating new memory
+    if (!tokens.empty()) {
+      row = tokens;
+      tokens.clear();
+      continue;
+    }
+
+    // Nothing more to match for any remaining separators
+    row.clear();
+    tokens.clear();
+    break;
+  }  // separators_
+
+  return Status::OK();
 }
 
 Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
                                                size_t N, size_t C,
                                                gsl::span<const int64_t> input_dims) const {
-  using namespace re2;
-
   auto X = ctx->Input<Tensor>(0);
   const auto input_span = X->DataAsSpan<std::string>();
 
@@ -365,92 +505,26 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
 
   std::vector<SlicesVector> rows;
   rows.reserve(vector_num);
-
-  // Re-use the same vector for each tokenization round
-  SlicesVector tokens = allocator.CreateVectorWithAllocator();
-  tokens.reserve(max_tokens_per_row);
-
-  // We do not constraint the search to match
-  // on the beginning or end of the string
-  constexpr RE2::Anchor anchor = RE2::UNANCHORED;
+  for (size_t i = 0; i < vector_num; ++i) {
+    allocator.EmplaceBack(rows);
+  }
 
   // Scan all strings and attempt to find separators in them
   // collect all the output tokens here
-  size_t max_tokens = 0;
-  for (const auto& s : input_span) {
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                  utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    const auto expected_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
-    auto& row = allocator.EmplaceBack(rows);
-    row.reserve(expected_tokens);
-    row.emplace_back(s);
-
-    for (const auto& sep : separators_) {
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
-
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-          if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + std::string{submatch});
-            }
-            if (utf8_chars >= mincharnum_) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
-          } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= mincharnum_) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
-          }
-        } while (match);
-      }  // row
-
-      // We want to preserve the buffer for the next separator
-      // copying slices is cheaper than allocating new memory
-      if (!tokens.empty()) {
-        row = tokens;
-        tokens.clear();
-        continue;
-      }
+  ORT_RETURN_IF_ERROR(ParallelForRows(
+      RowsThreadPool(ctx), vector_num, static_cast<double>(max_tokens_per_row) * 64.0 * separators_.size(),
+      [&](size_t first_row, size_t last_row) {
+        // Re-use the same vector for each tokenization round
+        SlicesVector tokens = allocator.CreateVectorWithAllocator();
+        tokens.reserve(max_tokens_per_row);
+        for (size_t r = first_row; r < last_row; ++r) {
+          ORT_RETURN_IF_ERROR(TokenizeWithSeparators(input_span[r], rows[r], tokens));
+        }
+        return Status::OK();
+      }));
 
-      // Nothing more to match for any remaining separators
-      row.clear();
-      tokens.clear();
-      break;
-    }  // separators_
+  size_t max_tokens = 0;
+  for (const auto& row : rows) {
     max_tokens = std::max(max_tokens, row.size());
   }
 
@@ -474,7 +548,57 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->MutableData<std::string>();
 
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
+  OutputData(ctx->GetOperatorThreadPool(), rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
+
+  return Status::OK();
+}
+
+Status Tokenizer::TokenizeWithExpression(const std::string& s, SlicesVector& row) const {
+  using namespace re2;
+
+  // We do not constraint the search to match
+  // on the beginning or end of the string
+  constexpr RE2::Anchor anchor = RE2::UNANCHORED;
+
+  size_t utf8_chars = 0;
+  utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars);
+
+  if (utf8_chars >= mincharnum_) {
+    auto estimated_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
+    row.reserve(estimated_tokens);
+
+    StringPiece text(s);
+    const auto end_pos = s.length();
+    size_t start_pos = 0;
+    StringPiece submatch;
+
+    bool match = true;
+    do {
+      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+      if (match) {
+        // Record  pos/len
+        assert(submatch.data() != nullptr);
+        size_t match_pos = submatch.data() - s.data();
+        assert(match_pos >= start_pos);
+        // Guard against empty match and make
+        // sure we make progress either way
+        auto token_len = submatch.length();
+        utf8_chars = 0;
+        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                        "Match contains invalid utf8 chars: " + std::string{submatch});
+        }
+        if (utf8_chars >= mincharnum_) {
+          row.push_back(submatch);
+          start_pos = match_pos + token_len;
+        } else {
+          size_t bytes = 0;
+          utf8_bytes(*submatch.data(), bytes);
+          start_pos = match_pos + bytes;
+        }
+      }
+    } while (match);
+  }
 
   return Status::OK();
 }
@@ -482,9 +606,6 @@ Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
 Status Tokenizer::TokenExpression(OpKernelContext* ctx,
                                   size_t N, size_t C,
                                   gsl::span<const int64_t> input_dims) const {
-  using namespace re2;
-
-  size_t max_tokens = 0;
   auto X = ctx->Input<Tensor>(0);
   const auto input_span = X->DataAsSpan<std::string>();
 
@@ -503,53 +624,21 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
   // with std::vector. It also deallocates memory, which is not what we want.
   std::vector<SlicesVector> rows;
   rows.reserve(vector_num);
+  for (size_t i = 0; i < vector_num; ++i) {
+    allocator.EmplaceBack(rows);
+  }
 
-  // We do not constraint the search to match
-  // on the beginning or end of the string
-  constexpr RE2::Anchor anchor = RE2::UNANCHORED;
-
-  for (const auto& s : input_span) {
-    size_t utf8_chars = 0;
-    utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars);
-
-    auto& row = allocator.EmplaceBack(rows);
-
-    if (utf8_chars >= mincharnum_) {
-      auto estimated_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
-      row.reserve(estimated_tokens);
-
-      StringPiece text(s);
-      const auto end_pos = s.length();
-      size_t start_pos = 0;
-      StringPiece submatch;
-
-      bool match = true;
-      do {
-        match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-        if (match) {
-          // Record  pos/len
-          assert(submatch.data() != nullptr);
-          size_t match_pos = submatch.data() - s.data();
-          assert(match_pos >= start_pos);
-          // Guard against empty match and make
-          // sure we make progress either way
-          auto token_len = submatch.length();
-          utf8_chars = 0;
-          if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
-            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                          "Match contains invalid utf8 chars: " + std::string{submatch});
-          }
-          if (utf8_chars >= mincharnum_) {
-            row.push_back(submatch);
-            start_pos = match_pos + token_len;
-          } else {
-            size_t bytes = 0;
-            utf8_bytes(*submatch.data(), bytes);
-            start_pos = match_pos + bytes;
-          }
+  ORT_RETURN_IF_ERROR(ParallelForRows(
+      RowsThreadPool(ctx), vector_num, static_cast<double>(max_tokens_per_row) * 64.0,
+      [&](size_t first_row, size_t last_row) {
+        for (size_t r = first_row; r < last_row; ++r) {
+          ORT_RETURN_IF_ERROR(TokenizeWithExpression(input_span[r], rows[r]));
         }
-      } while (match);
-    }
+        return Status::OK();
+      }));
+
+  size_t max_tokens = 0;
+  for (const auto& row : rows) {
     max_tokens = std::max(max_tokens, row.size());
   }
 
@@ -574,7 +663,7 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->MutableData<std::string>();
 
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
+  OutputData(ctx->GetOperatorThreadPool(), rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
 
   return Status::OK();
 }
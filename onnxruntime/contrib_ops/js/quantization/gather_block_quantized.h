@@ -30,6 +30,7 @@ class GatherBlockQuantized : public JsKernel {
 
     ORT_ENFORCE(block_size >= 16 && ((block_size - 1) & block_size) == 0,
                 "'block_size' must be 2's power and not less than 16.");
+    ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("bits", 4) == 4, "Only 4 bits data is supported.");
     JSEP_INIT_KERNEL_ATTRIBUTE(GatherBlockQuantized, ({
                                  "gatherAxis" : $1,
                                  "quantizeAxis" : $2,
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 #include "core/common/common.h"
 
 namespace onnxruntime {
@@ -36,6 +39,25 @@ inline bool utf8_bytes(unsigned char ch, size_t& len) {
   return false;
 }
 
+// Returns true if none of the bytes has the high bit set, i.e. the string is 7-bit ASCII.
+// Checks eight bytes at a time.
+inline bool is_ascii(const char* s, size_t len) {
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  for (; len >= sizeof(uint64_t); s += sizeof(uint64_t), len -= sizeof(uint64_t)) {
+    uint64_t v;
+    memcpy(&v, s, sizeof(uint64_t));
+    if ((v & kHighBits) != 0) {
+      return false;
+    }
+  }
+  for (; len > 0; ++s, --len) {
+    if ((static_cast<unsigned char>(*s) & 0x80) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Computes length of the utf8 string in characters
 inline bool utf8_len(const unsigned char* s, size_t bytes, size_t& len) {
   size_t result = 0;
@@ -192,6 +192,12 @@ class PlannerImpl {
 #endif
   const logging::Logger& logger_;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Outputs written over the buffer of one of their node's inputs, and their statically known size in bytes.
+  size_t num_inplace_outputs_{0};
+  size_t inplace_output_bytes_{0};
+#endif
+
   // OrtValueInfo: Auxiliary information about an OrtValue used only during plan-generation:
   struct OrtValueInfo {
     const onnxruntime::NodeArg* p_def_site;  // the (unique) NodeArg corresponding to the MLValue
@@ -551,6 +557,20 @@ class PlannerImpl {
     return SameSize(*p_shape1, arg1, *p_shape2, arg2);
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Size in bytes of a tensor if its shape is statically known, otherwise 0.
+  size_t StaticSizeInBytes(const onnxruntime::NodeArg& arg) {
+    auto p_shape = context_->GetShape(arg);
+    if (nullptr == p_shape || IsNonTensor(arg)) return 0;
+    size_t size = GetElementSize(arg.Type());
+    for (const auto& dim : p_shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return 0;
+      size *= static_cast<size_t>(dim.dim_value());
+    }
+    return size;
+  }
+#endif
+
   // Find if freelist contains a buffer of the same size as output_arg
   bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, OrtValueIndex* reusable_tensor) {
     if (!context_->GetEnableMemoryReuse()) {
@@ -1609,6 +1629,10 @@ class PlannerImpl {
           // possible candidates for re-use
           Reuse(reused, current, AllocKind::kReuse);
           ort_value_info_[current].is_inplace_reuse = true;
+#if !defined(ORT_MINIMAL_BUILD)
+          ++num_inplace_outputs_;
+          inplace_output_bytes_ += StaticSizeInBytes(*node_output);
+#endif
 #ifdef ENABLE_STRIDED_TENSORS
           if (is_strided_tensor) AllocPlan(current).is_strided_tensor = true;
 #else
@@ -2368,6 +2392,19 @@ Status PlannerImpl::CreatePlan(
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // report the peak memory of the activations for the selected execution order, so the orders can be compared
+  if (logger_.OutputIsEnabled(logging::Severity::kINFO, logging::DataType::SYSTEM)) {
+    const auto& node_order = graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder());
+    LOGS(logger_, INFO) << "Planned peak memory of the activations of graph '" << graph_viewer_.Name() << "' with "
+                        << context_->GetExecutionOrder() << " execution order: "
+                        << graph_viewer_.GetGraph().EstimatePeakMemory(node_order) << " bytes";
+    LOGS(logger_, INFO) << num_inplace_outputs_ << " outputs of graph '" << graph_viewer_.Name()
+                        << "' are written in place over an input, saving " << inplace_output_bytes_
+                        << " bytes of statically known size";
+  }
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Adjust the allocate and lifetime intervals for all ml-values, based on their allocation kind.
   AdjustInplaceLifeIntervals();
@@ -419,205 +419,275 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
     const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      if (sess_options_.IsLoadCancellationFlagSet()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
-                               "Weight pre-packing was canceled due to user request.");
-      }
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          auto* prepacked_for_graph = &graph_.GetPrepacked();
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {
-                  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
-                  // because other static properties of the node like node attributes could play a role in the
-                  // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
-                    // to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
-                                "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string prepacked_weights_container_key =
-                        GenerateKeyForPrepackedWeightsMap(op_type,
-                                                          weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
-                        prepacked_weights_container_key);
+  // Nodes may be pre-packed concurrently. This guards the pre-packed weight containers and the counters.
+  // PrePack() itself runs without it. Kernels may look up other constant inputs from within PrePack() via
+  // OpKernelInfo::TryGetConstantInput, so while nodes are pre-packed concurrently the constant initializer maps
+  // must not change: releasing fully packed initializers is deferred to `deferred_releases` until all nodes are done.
+  std::mutex prepack_mutex;
+  std::vector<std::pair<SessionState*, int>> deferred_releases;
+  bool defer_releases = false;
+
+  auto prepack_node_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                        &prepack_mutex, &deferred_releases, &defer_releases](
+                                           const Node& node,
+                                           bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        auto* prepacked_for_graph = &graph_.GetPrepacked();
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            std::unique_lock<std::mutex> lock(prepack_mutex);
+            std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            if (constant_initialized_tensors.count(ort_value_idx)) {
+              bool is_packed = false;
+              const Tensor& const_initialized_tensor = constant_initialized_tensors.at(ort_value_idx).Get<Tensor>();
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+              if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                  node.GetExecutionProviderType() == kCpuExecutionProvider) {
+                // caching of pre-packed weights' turned ON
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
+                // because other static properties of the node like node attributes could play a role in the
+                // pre-packed weights' contents.
+                lock.unlock();
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
+                lock.lock();
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
-                                          << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: "
-                                          << node.OpType();
-
-                      const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_shared,
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-
-                      // Write references to what is stored in the shared container
-                      // and release memory mapped entries this container may have loaded from disk
-                      std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
-                                                                                      prepacked_weights_container_key,
-                                                                                      prepacked_shared);
-
-                    } else {
-                      // container doesn't contain the pre-packed weight - so write into it for sharing across
-                      // kernel instances
-
-                      // Check if we loaded it from disk, then put it into the shared container so
-                      // everybody can share the same memory mapped entry
-                      // the shared container takes ownership of the memory mapped entries
-
-                      // The next line replaces the existing entry with references to it
-                      // and returns the container that holds the memory mapped entries
-                      // so we can transfer it to shared container.
-                      // if there is not an entry, we replace it with references to weights_to_be_filled_in
-                      // in saving mode and return std::nullopt
-                      auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
-                          input_name,
-                          prepacked_weights_container_key,
-                          weights_to_be_filled_in);
-
-                      if (prepacked_from_disk.has_value()) {
-                        weights_to_be_filled_in = std::move(*prepacked_from_disk);
-                      }
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
-                                                                     std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(
-                            ONNXRUNTIME, FAIL,
-                            "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          shared_prepacked,
-                                                                          node.Name()));
-                    }
-                  }
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
+                  // to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
+                              "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                } else {
-                  // cross session caching of pre-packed weights' turned OFF
-                  // we use serialization container to share weights loaded from disk
-                  // within this session. Or if the weight is not present on disk,
-                  // we store the newly minted pre-packed data.
-
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
-                  // other static properties of the node like node attributes could play a role in the pre-packed
-                  // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
-                  // even though they set is_packed = true so we leave it up to them.
-                  // We can change their behavior if we wish do so in a separate PR
-                  // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
-                  // produce them.
-                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
-                    const auto& op_type = node.OpType();
-                    const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
-                        op_type,
-                        weights_to_be_filled_in);
+                  const auto& op_type = node.OpType();
+
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
+
+                  const std::string prepacked_weights_container_key =
+                      GenerateKeyForPrepackedWeightsMap(op_type,
+                                                        weights_to_be_filled_in);
+
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
+                      prepacked_weights_container_key);
 
-                    // See if we can use pre-packed data from disk
-                    const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
+                                        << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: "
+                                        << node.OpType();
+
+                    const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
                         prepacked_weights_container_key);
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_shared,
+                                                                        node.Name()));
 
-                    if (weights_to_use == nullptr) {
-                      // In this case pre-packed container owns the data
-                      prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
-                                                                   std::move(weights_to_be_filled_in));
-                      weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
-                      assert(weights_to_use != nullptr);
+                    ++used_shared_pre_packed_weights_counter_;
+
+                    // Write references to what is stored in the shared container
+                    // and release memory mapped entries this container may have loaded from disk
+                    std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
+                                                                                    prepacked_weights_container_key,
+                                                                                    prepacked_shared);
+
+                  } else {
+                    // container doesn't contain the pre-packed weight - so write into it for sharing across
+                    // kernel instances
+
+                    // Check if we loaded it from disk, then put it into the shared container so
+                    // everybody can share the same memory mapped entry
+                    // the shared container takes ownership of the memory mapped entries
+
+                    // The next line replaces the existing entry with references to it
+                    // and returns the container that holds the memory mapped entries
+                    // so we can transfer it to shared container.
+                    // if there is not an entry, we replace it with references to weights_to_be_filled_in
+                    // in saving mode and return std::nullopt
+                    auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
+                        input_name,
+                        prepacked_weights_container_key,
+                        weights_to_be_filled_in);
+
+                    if (prepacked_from_disk.has_value()) {
+                      weights_to_be_filled_in = std::move(*prepacked_from_disk);
                     }
 
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                                   std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(
+                          ONNXRUNTIME, FAIL,
+                          "Unable to write the provided PrePackedWeights instance into the container");
+                    }
+
+                    const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
+                        prepacked_weights_container_key);
                     ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                        *weights_to_use,
+                                                                        shared_prepacked,
                                                                         node.Name()));
                   }
                 }
 
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
+              } else {
+                // cross session caching of pre-packed weights' turned OFF
+                // we use serialization container to share weights loaded from disk
+                // within this session. Or if the weight is not present on disk,
+                // we store the newly minted pre-packed data.
+
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
+                // other static properties of the node like node attributes could play a role in the pre-packed
+                // weights' contents.
+                lock.unlock();
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
+                lock.lock();
+
+                // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
+                // even though they set is_packed = true so we leave it up to them.
+                // We can change their behavior if we wish do so in a separate PR
+                // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
+                // produce them.
+                if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                  const auto& op_type = node.OpType();
+                  const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
+                      op_type,
+                      weights_to_be_filled_in);
+
+                  // See if we can use pre-packed data from disk
+                  const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                      prepacked_weights_container_key);
+
+                  if (weights_to_use == nullptr) {
+                    // In this case pre-packed container owns the data
+                    prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
+                                                                 std::move(weights_to_be_filled_in));
+                    weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
+                    assert(weights_to_use != nullptr);
+                  }
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      *weights_to_use,
+                                                                      node.Name()));
+                }
+              }
+
+              if (is_packed) {
+                ++number_of_prepacks_counter_;
 
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
+                if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+                  // release the constant initialized tensor
+                  if (defer_releases) {
+                    deferred_releases.emplace_back(st, ort_value_idx);
+                  } else {
                     st->initialized_tensors_.erase(ort_value_idx);
                     constant_initialized_tensors.erase(ort_value_idx);
                   }
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
-              }
             }
-            st = st->Parent();
-            prepacked_for_graph = &st->graph_.GetPrepacked();
-          } while (st);
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+          prepacked_for_graph = &st->graph_.GetPrepacked();
+        } while (st);
+      }
+      input_idx++;
+    }
+
+    return Status::OK();
+  };
+
+  auto prepack_constant_weights = [this, &prepack_node_constant_weights, &deferred_releases, &defer_releases](
+                                      bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    InlinedVector<const Node*> nodes;
+    for (const auto& node : GetGraphViewer().Nodes()) {
+      nodes.push_back(&node);
+    }
+
+    const bool parallel_prepack =
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelInitialization, "0") == "1" &&
+        concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) > 1 && nodes.size() > 1;
+
+    if (!parallel_prepack) {
+      for (const Node* node : nodes) {
+        if (sess_options_.IsLoadCancellationFlagSet()) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                                 "Weight pre-packing was canceled due to user request.");
         }
-        input_idx++;
+        ORT_RETURN_IF_ERROR(prepack_node_constant_weights(*node,
+                                                          should_cache_prepacked_weights_for_shared_initializers));
       }
+      return Status::OK();
     }
 
+    // The inputs of a node are still pre-packed in order as a kernel may rely on that.
+    defer_releases = true;
+    std::vector<Status> node_status(nodes.size());
+    auto prepack_node = [&](std::ptrdiff_t i) {
+      if (sess_options_.IsLoadCancellationFlagSet()) {
+        node_status[i] = ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
+                                         "Weight pre-packing was canceled due to user request.");
+        return;
+      }
+      ORT_TRY {
+        node_status[i] = prepack_node_constant_weights(*nodes[i],
+                                                       should_cache_prepacked_weights_for_shared_initializers);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          node_status[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+        });
+      }
+    };
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool_, static_cast<std::ptrdiff_t>(nodes.size()),
+                                                  prepack_node);
+
+    // every node is done with the constant initializers now so the fully packed ones can be released
+    for (const auto& [st, ort_value_idx] : deferred_releases) {
+      st->initialized_tensors_.erase(ort_value_idx);
+      st->constant_initialized_tensors_.erase(ort_value_idx);
+    }
+
+    for (const auto& status : node_status) {
+      ORT_RETURN_IF_ERROR(status);
+    }
     return Status::OK();
   };
 
@@ -627,9 +697,9 @@ Status SessionState::PrepackConstantInitializedTensors(
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    return prepack_constant_weights(true);
   } else {
-    return prepacked_constant_weights(false);
+    return prepack_constant_weights(false);
   }
 }
 
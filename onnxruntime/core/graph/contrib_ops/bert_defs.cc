@@ -1673,6 +1673,40 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
         .TypeAndShapeInferenceFunction(SkipLayerNormalizationShapeInference));
 
+constexpr const char* EncoderFeedForward_ver1_doc = R"DOC(
+The feed forward block of a transformer encoder layer with its residual connection and layer normalization:
+
+  output = LayerNormalization(input + Activation(input * weight1 + bias1) * weight2 + bias2) * gamma + beta
+
+This is the fusion of MatMul, BiasGelu (or FastGelu with bias), MatMul and SkipLayerNormalization.
+Rows of the input are processed in tiles so that the (rows, intermediate_size) activation of a tile stays in cache
+between the two projections.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    EncoderFeedForward, 1,
+    OpSchema()
+        .SetDoc(EncoderFeedForward_ver1_doc)
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, kDefaultSkipLayerNormEpsilon)
+        .Attr("activation",
+              "Activation applied after the first projection: Gelu or FastGelu.",
+              AttributeProto::STRING,
+              std::string("Gelu"))
+        .Input(0,
+               "input",
+               "3D input tensor with shape (batch_size, sequence_length, hidden_size)"
+               "Or 2D input tensor with shape (token_count, hidden_size). It is also the residual.",
+               "T")
+        .Input(1, "weight1", "2D weight of the first projection with shape (hidden_size, intermediate_size)", "T")
+        .Input(2, "bias1", "1D bias of the first projection with shape (intermediate_size)", "T")
+        .Input(3, "weight2", "2D weight of the second projection with shape (intermediate_size, hidden_size)", "T")
+        .Input(4, "gamma", "1D input tensor with shape (hidden_size)", "T")
+        .Input(5, "beta", "1D input tensor with shape (hidden_size)", "T", OpSchema::Optional)
+        .Input(6, "bias2", "1D bias of the second projection with shape (hidden_size)", "T", OpSchema::Optional)
+        .Output(0, "output", "Output tensor with the same shape as input", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 constexpr const char* NGramRepeatBlock_ver1_doc = R"DOC(
 Enforce no repetition of n-grams. Scores are set to `-inf` for tokens that form a repeated n-gram if added to the back of the input_ids.
 )DOC";
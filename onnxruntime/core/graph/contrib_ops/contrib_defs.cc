@@ -2226,6 +2226,41 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedMatMulActivation, 1,
                                 .SetDoc(FusedMatMulActivation_doc)
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) { FusedMatMulShapeInference(ctx); }));
 
+constexpr const char* FusedElementwise_doc = R"DOC(
+Evaluates a chain of element-wise operators in a single pass over the data, reading each input once and writing
+the output once.
+The chain is a list of steps. Step i applies ops[i] to the registers in operands[3 * i] to operands[3 * i + 2] and
+stores the result in register N + i, where N is the number of inputs. Registers 0 to N - 1 hold the inputs.
+Unused operands are -1. The result of the last step is the output.
+Supported ops are Add, Sub, Mul, Div, Sqrt, Erf, Tanh and Where. All inputs are broadcast to the output shape
+using multidirectional (Numpy-style) broadcasting. Boolean inputs are read as 0 and 1, for the condition of Where.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedElementwise, 1,
+                            OpSchema()
+                                .SetDoc(FusedElementwise_doc)
+                                .Attr("ops", "The operator of each step.", AttributeProto::STRINGS)
+                                .Attr("operands", "Three register indices per step. Unused operands are -1.",
+                                      AttributeProto::INTS)
+                                .Input(0, "inputs", "Input tensors of the chain.", "T1", OpSchema::Variadic, false)
+                                .Output(0, "Y", "Result of the last step.", "T")
+                                .TypeConstraint("T1", {"tensor(float)", "tensor(bool)"},
+                                                "Constrain inputs to float tensors, or bool tensors for conditions.")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain output to float tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+                                  const size_t num_inputs = ctx.getNumInputs();
+                                  if (!hasNInputShapes(ctx, static_cast<int>(num_inputs))) {
+                                    return;
+                                  }
+                                  std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+                                  for (size_t i = 0; i < num_inputs; ++i) {
+                                    shapes.push_back(&ctx.getInputType(i)->tensor_type().shape());
+                                  }
+                                  multidirectionalBroadcastShapeInference(
+                                      shapes, *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                             OpSchema()
                                 .Input(0, "A", "2-dimensional sparse matrix A. Either COO or CSR format", "T")
@@ -2399,6 +2434,95 @@ ONNX_MS_OPERATOR_SET_SCHEMA(WordConvEmbedding, 1,
                                     "Constrain to tensor(float).")
                                 .SetDoc(R"DOC(The WordConvEmbedding takes in a batch of sequence words and embed each word to a vector.)DOC"));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(EmbeddingBag, 1,
+                            OpSchema()
+                                .Attr(
+                                    "mode",
+                                    "Pooling applied to the rows of a bag: `sum`(default) or `mean`. "
+                                    "`mean` divides the (weighted) sum by the number of indices in the bag.",
+                                    AttributeProto::STRING,
+                                    std::string("sum"))
+                                .Input(0, "data", "Embedding table of shape [num_embeddings, embedding_dim].", "T")
+                                .Input(
+                                    1,
+                                    "indices",
+                                    "Rows to look up. Without `offsets` the last dimension holds the bags, "
+                                    "i.e. indices of shape [..., bag_size] produce [..., embedding_dim]. "
+                                    "With `offsets` it must be 1-D and holds all bags back to back. "
+                                    "Negative values count from the end of the table as in Gather.",
+                                    "Tind")
+                                .Input(
+                                    2,
+                                    "offsets",
+                                    "Optional 1-D tensor of shape [num_bags] with the non-decreasing start position of each bag in "
+                                    "`indices`. Bag i spans [offsets[i], offsets[i + 1]), the last bag ends at the end of `indices`.",
+                                    "Tind",
+                                    OpSchema::Optional)
+                                .Input(
+                                    3,
+                                    "per_sample_weights",
+                                    "Optional weights applied to each looked up row before pooling. It must have as many elements "
+                                    "as `indices`; a trailing dimension of 1 is accepted.",
+                                    "T",
+                                    OpSchema::Optional)
+                                .Output(0, "output", "Pooled embeddings, [num_bags, embedding_dim] with `offsets` and "
+                                                     "indices_shape[:-1] + [embedding_dim] without.",
+                                        "T")
+                                .TypeConstraint(
+                                    "T",
+                                    {"tensor(float)", "tensor(float16)"},
+                                    "Constrain table and output types to float tensors.")
+                                .TypeConstraint(
+                                    "Tind",
+                                    {"tensor(int32)", "tensor(int64)"},
+                                    "Constrain indices and offsets to integer types.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (!hasNInputShapes(ctx, 2)) {
+                                    return;
+                                  }
+
+                                  auto& data_shape = getInputShape(ctx, 0);
+                                  auto& indices_shape = getInputShape(ctx, 1);
+                                  if (data_shape.dim_size() != 2) {
+                                    fail_shape_inference("data must be 2-D.");
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  if (ctx.hasInput(2)) {
+                                    if (indices_shape.dim_size() != 1) {
+                                      fail_shape_inference("indices must be 1-D when offsets is provided.");
+                                    }
+                                    if (!hasInputShape(ctx, 2)) {
+                                      return;
+                                    }
+                                    auto& offsets_shape = getInputShape(ctx, 2);
+                                    if (offsets_shape.dim_size() != 1) {
+                                      fail_shape_inference("offsets must be 1-D.");
+                                    }
+                                    *output_shape.add_dim() = offsets_shape.dim(0);
+                                  } else {
+                                    if (indices_shape.dim_size() < 1) {
+                                      fail_shape_inference("indices must have rank >= 1 when offsets is not provided.");
+                                    }
+                                    for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+                                      *output_shape.add_dim() = indices_shape.dim(i);
+                                    }
+                                  }
+                                  *output_shape.add_dim() = data_shape.dim(1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                })
+                                .SetDoc(R"DOC(
+Pools rows of an embedding table without materializing the gathered rows. It computes the same result as
+Gather(data, indices, axis=0) followed by an optional Mul with per_sample_weights and ReduceSum/ReduceMean over the
+bag dimension, in a single pass over the table.
+Example:
+  data    = [[1,2],[3,4],[5,6]]
+  indices = [0,2,1,1,2]
+  offsets = [0,2]
+  output  = [[6,8],[11,14]]   (mode = sum)
+)DOC"));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(Pad, 1,
                             OpSchema()
                                 .Attr(
@@ -3571,11 +3695,15 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
   1. Input `data` is a constant. It is quantized block-wise along attribute `quantize_axis` with block size specified by attribute `block_size`.
      `block_size must` be a power of 2 and not smaller than 16, like 16, 32, 64, 128, ..
   2. Input `data`'s scale and zero point are specified by input `scales` and `zero_points`. `scales` and `zero_points` are also constants.
-     If `zero_points` is not provided, 0 is the zero point except when data is uint8 type then the default zero point is 8.
+     If `zero_points` is not provided, 0 is the zero point except when data is uint8 type then the default zero point is 8
+     for 4 bits and 128 for 8 bits.
   3. During the op execution, `data` and `indices` are first used to generate the quantized output. Then, `scales` and `zero_points` are used
      to dequantize the output.
   4. The `output` and `scales` have the same type. The `data` and `zero_points` have the same type.
-  5. For uint8 data, the `gather_axis` must be 0.
+  5. For uint8 data with 4 bits, two elements are packed in each byte and the `gather_axis` must be 0.
+     zero_points are only supported for uint8 data with 8 bits.
+  6. Setting `block_size` to at least the size of `quantize_axis` gives one scale (and zero point) per row, i.e. a
+     row-wise quantized embedding table when `quantize_axis` is the last axis.
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(GatherBlockQuantized)
@@ -3594,6 +3722,10 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
             "(Optional) block size used for weight quantization. It needs to be a power of 2 and not smaller than 16.",
             AttributeProto::INT,
             static_cast<int64_t>(128))
+      .Attr("bits",
+            "(Optional) Number of bits of each quantized element, 4 or 8. 8 is only supported for uint8 data.",
+            AttributeProto::INT,
+            static_cast<int64_t>(4))
       .Input(0, "data", "Tensor of rank r >= 1. Block-wise quantized.", "T1")
       .Input(1,
              "indices",
@@ -3625,6 +3757,7 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
         int gather_axis = static_cast<int>(getAttribute(ctx, "gather_axis", 0));
         int quantize_axis = static_cast<int>(getAttribute(ctx, "quantize_axis", 1));
         auto block_size = getAttribute(ctx, "block_size", 128);
+        auto bits = getAttribute(ctx, "bits", 4);
         if (gather_axis < -r || gather_axis >= r) {
           fail_shape_inference("gather_axis must be in [-r, r-1]");
         }
@@ -3638,15 +3771,20 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
         gather_axis = (gather_axis + r) % r;
         quantize_axis = (quantize_axis + r) % r;
 
-        if ((ctx.getInputType(0)->tensor_type().elem_type() == onnx::TensorProto_DataType_UINT8) && gather_axis != 0) {
-          fail_shape_inference("gather_axis must be 0, for uint8 data");
+        const bool is_uint8 = ctx.getInputType(0)->tensor_type().elem_type() == onnx::TensorProto_DataType_UINT8;
+        if (bits != 4 && !(bits == 8 && is_uint8)) {
+          fail_shape_inference("bits must be 4, or 8 for uint8 data");
+        }
+
+        if (is_uint8 && bits == 4 && gather_axis != 0) {
+          fail_shape_inference("gather_axis must be 0, for uint8 data with 4 bits");
         }
 
         if (scales_shape.dim_size() != r) {
           fail_shape_inference("scales must have the same rank as data");
         }
 
-        uint32_t components = ctx.getInputType(0)->tensor_type().elem_type() == onnx::TensorProto_DataType_UINT8 ? 2 : 1;
+        uint32_t components = is_uint8 && bits == 4 ? 2 : 1;
         for (int i = 0; i < r; ++i) {
           if (!data_shape.dim(i).has_dim_value() ||
               !scales_shape.dim(i).has_dim_value() ||
@@ -3658,8 +3796,8 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
 
         // validate zero point shape
         if (ctx.hasInput(3)) {
-          if (ctx.getInputType(0)->tensor_type().elem_type() == onnx::TensorProto_DataType_UINT8) {
-            fail_type_inference("zero_points are not supported for uint8_t data type");
+          if (is_uint8 && bits == 4) {
+            fail_type_inference("zero_points are not supported for uint8_t data type with 4 bits");
           }
 
           if (!hasInputShape(ctx, 3)) {
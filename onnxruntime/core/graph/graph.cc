@@ -6,6 +6,7 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <queue>
 #include <stack>
@@ -40,6 +41,7 @@
 #include "core/graph/function.h"
 #include "core/graph/function_impl.h"
 #include "core/graph/schema_registry.h"
+#include "core/graph/symbolic_shape_inference.h"
 #include "onnx/checker.h"
 using namespace ONNX_NAMESPACE::checker;
 #endif
@@ -1964,6 +1966,216 @@ void Graph::KahnsTopologicalSort(const std::function<void(const Node*)>& enter,
   }
 }
 
+namespace {
+
+// Size in bytes of a tensor from its inferred shape, with symbolic dimensions counted as 1.
+// Non-tensor values and tensors without a shape count as 0.
+size_t EstimateTensorSizeInBytes(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !utils::HasTensorType(*type) || !utils::HasShape(type->tensor_type())) {
+    return 0;
+  }
+
+  ONNX_NAMESPACE::TypeProto_Tensor tensor_type = type->tensor_type();
+  for (auto& dim : *tensor_type.mutable_shape()->mutable_dim()) {
+    if (!utils::HasDimValue(dim)) {
+      dim.set_dim_value(1);
+    }
+  }
+
+  size_t size = 0;
+  return utils::GetSizeInBytesFromTensorTypeProto<0>(tensor_type, &size).IsOK() ? size : 0;
+}
+
+// Follows the tensors produced by the nodes of a graph while the nodes run in some order.
+// A tensor is live from when its producer runs until its last consumer has run. Graph outputs stay live until the end.
+class LiveTensorTracker {
+ public:
+  explicit LiveTensorTracker(const Graph& graph) : has_run_(graph.MaxNodeIndex(), false) {
+    InlinedHashSet<const NodeArg*> graph_outputs(graph.GetOutputs().cbegin(), graph.GetOutputs().cend());
+    for (const auto& node : graph.Nodes()) {
+      for (const NodeArg* output : node.OutputDefs()) {
+        if (output->Exists()) {
+          auto& tensor = tensors_[output];
+          tensor.size = EstimateTensorSizeInBytes(*output);
+          tensor.is_graph_output = graph_outputs.count(output) != 0;
+        }
+      }
+    }
+
+    for (const auto& node : graph.Nodes()) {
+      for (const NodeArg* input : TrackedInputs(node)) {
+        auto& tensor = tensors_[input];
+        ++tensor.remaining_consumers;
+        tensor.consumers.push_back(&node);
+      }
+    }
+  }
+
+  // Change of the live bytes if the node runs next.
+  int64_t NetAllocation(const Node& node) const {
+    int64_t net = 0;
+    for (const NodeArg* output : node.OutputDefs()) {
+      auto it = tensors_.find(output);
+      // an output nobody consumes is released as soon as the node is done
+      if (it != tensors_.end() && (it->second.remaining_consumers > 0 || it->second.is_graph_output)) {
+        net += static_cast<int64_t>(it->second.size);
+      }
+    }
+    for (const NodeArg* input : TrackedInputs(node)) {
+      const auto& tensor = tensors_.at(input);
+      if (tensor.remaining_consumers == 1 && !tensor.is_graph_output) {
+        net -= static_cast<int64_t>(tensor.size);
+      }
+    }
+    return net;
+  }
+
+  // Runs the node and returns the live bytes while it runs, when its inputs and outputs are all allocated.
+  // If an input of the node is left with a single consumer, running that consumer now releases the input, so its
+  // net allocation decreases. Such consumers are added to nodes_with_lower_net_allocation if it is given.
+  size_t Run(const Node& node, InlinedVector<const Node*>* nodes_with_lower_net_allocation = nullptr) {
+    has_run_[node.Index()] = true;
+    for (const NodeArg* output : node.OutputDefs()) {
+      auto it = tensors_.find(output);
+      if (it != tensors_.end()) {
+        live_bytes_ += it->second.size;
+      }
+    }
+    const size_t node_peak = live_bytes_;
+
+    for (const NodeArg* input : TrackedInputs(node)) {
+      auto& tensor = tensors_[input];
+      --tensor.remaining_consumers;
+      if (tensor.is_graph_output) {
+        continue;
+      }
+      if (tensor.remaining_consumers == 0) {
+        live_bytes_ -= tensor.size;
+      } else if (tensor.remaining_consumers == 1 && nodes_with_lower_net_allocation != nullptr) {
+        for (const Node* consumer : tensor.consumers) {
+          if (!has_run_[consumer->Index()]) {
+            nodes_with_lower_net_allocation->push_back(consumer);
+          }
+        }
+      }
+    }
+    for (const NodeArg* output : node.OutputDefs()) {
+      auto it = tensors_.find(output);
+      if (it != tensors_.end() && it->second.remaining_consumers == 0 && !it->second.is_graph_output) {
+        live_bytes_ -= it->second.size;
+      }
+    }
+    return node_peak;
+  }
+
+ private:
+  struct TensorInfo {
+    size_t size{0};
+    size_t remaining_consumers{0};
+    bool is_graph_output{false};
+    InlinedVector<const Node*> consumers;
+  };
+
+  // The distinct explicit and implicit inputs of the node that are produced by a node of the graph.
+  InlinedVector<const NodeArg*> TrackedInputs(const Node& node) const {
+    InlinedVector<const NodeArg*> inputs;
+    auto add_inputs = [&](const ConstPointerContainer<std::vector<NodeArg*>>& defs) {
+      for (const NodeArg* input : defs) {
+        if (tensors_.count(input) != 0 && std::find(inputs.cbegin(), inputs.cend(), input) == inputs.cend()) {
+          inputs.push_back(input);
+        }
+      }
+    };
+    add_inputs(node.InputDefs());
+    add_inputs(node.ImplicitInputDefs());
+    return inputs;
+  }
+
+  InlinedHashMap<const NodeArg*, TensorInfo> tensors_;
+  std::vector<bool> has_run_;
+  size_t live_bytes_{0};
+};
+
+}  // namespace
+
+size_t Graph::MemoryAwareTopologicalSort(std::vector<NodeIndex>& node_orders) const {
+  LiveTensorTracker tracker(*this);
+  InlinedVector<size_t> in_degree(MaxNodeIndex(), 0);
+
+  // The ready nodes ordered by net allocation. Ties go to the node with the lower index, which keeps the order of the
+  // model where it doesn't matter. The net allocation of a ready node only changes when another consumer of one of
+  // its inputs runs, and then it decreases. The node is pushed again with the new value, and entries that don't match
+  // ready_net_allocation any more are skipped.
+  using ReadyNode = std::pair<int64_t, NodeIndex>;
+  std::priority_queue<ReadyNode, std::vector<ReadyNode>, std::greater<ReadyNode>> ready;
+  constexpr int64_t kNotReady = std::numeric_limits<int64_t>::max();
+  InlinedVector<int64_t> ready_net_allocation(MaxNodeIndex(), kNotReady);
+
+  auto push_ready = [&](const Node& node) {
+    const int64_t net = tracker.NetAllocation(node);
+    ready_net_allocation[node.Index()] = net;
+    ready.emplace(net, node.Index());
+  };
+
+  for (auto& node : Nodes()) {
+    size_t input_edge_count = node.GetInputEdgesCount();
+    in_degree[node.Index()] = input_edge_count;
+    if (input_edge_count == 0) {
+      push_ready(node);
+    }
+  }
+
+  node_orders.clear();
+  node_orders.reserve(NumberOfNodes());
+  size_t peak = 0;
+  InlinedVector<const Node*> nodes_with_lower_net_allocation;
+
+  while (!ready.empty()) {
+    const auto [net, index] = ready.top();
+    ready.pop();
+    if (ready_net_allocation[index] != net) {
+      continue;
+    }
+    ready_net_allocation[index] = kNotReady;
+
+    const Node* current = GetNode(index);
+    nodes_with_lower_net_allocation.clear();
+    peak = std::max(peak, tracker.Run(*current, &nodes_with_lower_net_allocation));
+    node_orders.push_back(index);
+
+    for (const Node* node : nodes_with_lower_net_allocation) {
+      if (ready_net_allocation[node->Index()] != kNotReady) {
+        push_ready(*node);
+      }
+    }
+
+    for (auto node_it = current->OutputNodesBegin(); node_it != current->OutputNodesEnd(); ++node_it) {
+      if (--in_degree[node_it->Index()] == 0) {
+        push_ready(*node_it);
+      }
+    }
+  }
+
+  if (NumberOfNodes() != static_cast<int>(node_orders.size())) {
+    ORT_THROW("Some nodes are not included in the topological sort, graph have a cycle.");
+  }
+
+  return peak;
+}
+
+size_t Graph::EstimatePeakMemory(gsl::span<const NodeIndex> node_orders) const {
+  LiveTensorTracker tracker(*this);
+  size_t peak = 0;
+  for (NodeIndex node_index : node_orders) {
+    const Node* node = GetNode(node_index);
+    if (node != nullptr) {
+      peak = std::max(peak, tracker.Run(*node));
+    }
+  }
+  return peak;
+}
+
 #ifdef ENABLE_TRAINING
 
 namespace {
@@ -2616,11 +2828,13 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
   InferenceContextImpl(Node& node,
                        SubgraphInferencingFunc subgraph_inferencing_func,
                        const Graph& graph,
-                       const Graph::ResolveOptions& options) noexcept
+                       const Graph::ResolveOptions& options,
+                       symbolic_shape_inference::SymbolicDataMap& symbolic_data) noexcept
       : node_(node),
         subgraph_inferencing_func_(subgraph_inferencing_func),
         graph_(graph),
-        options_(options) {
+        options_(options),
+        symbolic_data_(symbolic_data) {
     node_output_types_.resize(node.OutputDefs().size());
   }
 
@@ -2629,6 +2843,12 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
     if (nullptr != schema) {
       schema->GetTypeAndShapeInferenceFunction()(*this);
     }
+
+    // ONNX inference leaves dims it can't compute as a constant unknown, e.g. the Concat of `past_len` and
+    // `seq_len`. fill those in with dim expressions, and track the symbolic values of shape tensors so that
+    // consumers like Reshape can see them via getSymbolicInput.
+    symbolic_shape_inference::RefineOutputShapes(node_, graph_, symbolic_data_, node_output_types_);
+    symbolic_shape_inference::PropagateSymbolicData(node_, graph_, node_output_types_, symbolic_data_);
   }
 
   std::vector<TypeProto> InferredOutputTypes() const { return node_output_types_; }
@@ -2675,9 +2895,16 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
     return initializer;
   }
 
-  // ORT does not implement partial data propagation yet so just return nullptr.
-  const TensorShapeProto* getSymbolicInput(size_t) const override {
-    return nullptr;
+  // Returns the symbolic value of an input that was computed from shapes (e.g. the output of Shape -> Concat).
+  // Constant initializers are returned by getInputData instead.
+  const TensorShapeProto* getSymbolicInput(size_t index) const override {
+    auto def = node_.InputDefs()[index];
+    if (!def || !def->Exists()) {
+      return nullptr;
+    }
+
+    auto it = symbolic_data_.find(def->Name());
+    return it != symbolic_data_.end() ? &it->second : nullptr;
   }
 
   GraphInferencer* getGraphAttributeInferencer(const std::string& attribute_name) override {
@@ -2711,6 +2938,7 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
   std::vector<std::unique_ptr<GraphInferencerImpl>> graph_inferencers_;
   const Graph& graph_;
   const Graph::ResolveOptions& options_;
+  symbolic_shape_inference::SymbolicDataMap& symbolic_data_;
 };
 
 Status Graph::InferAndVerifySubgraphTypes(const Node& node, Graph& subgraph,
@@ -2903,7 +3131,7 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
   // Once that completes, the outputs from the node containing the subgraph will be updated, and the final values
   // returned here.
   SubgraphInferencingFunc func(Graph::InferAndVerifySubgraphTypes);
-  InferenceContextImpl context(node, func, *this, options);
+  InferenceContextImpl context(node, func, *this, options, resolve_context_.symbolic_data);
 
   {
     auto status = Status::OK();
@@ -3284,6 +3512,9 @@ Status Graph::InitInputsInitializersOutputs() {
     node.MutableDefinitions().implicit_input_defs.clear();
   }
 
+  // symbolic values recorded by UpdateShapeInference since the last Resolve may be stale.
+  resolve_context_.symbolic_data.clear();
+
   // add the subgraph pointers to the resolve context.
   for (auto& node : Nodes()) {
     auto& subgraphs = node.MutableSubgraphs();
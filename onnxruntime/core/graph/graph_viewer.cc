@@ -136,19 +136,19 @@ GraphViewer::GraphViewer(const Graph& graph, const IndexedSubGraph* filter_info)
 
 #ifdef ENABLE_TRAINING
   if (yield_node != nullptr) {
-    std::vector<NodeIndex> node_orders;
-    const size_t num_of_nodes = NumberOfNodes();
-    node_orders.reserve(num_of_nodes);
-    graph_->MemoryEfficientTopologicalSort(
-        yield_node,
-        shape_size_parents,
-        node_orders);
-
-    ORT_ENFORCE(node_orders.size() == num_of_nodes,
-                "Topological sort failed.", node_orders.size(), "!=", num_of_nodes);
-    nodes_in_mem_efficient_topological_order_ = std::move(node_orders);
-  } else {
-    nodes_in_mem_efficient_topological_order_ = nodes_in_topological_order_;
+    std::call_once(mem_efficient_order_flag_, [&]() {
+      std::vector<NodeIndex> node_orders;
+      const size_t num_of_nodes = NumberOfNodes();
+      node_orders.reserve(num_of_nodes);
+      graph_->MemoryEfficientTopologicalSort(
+          yield_node,
+          shape_size_parents,
+          node_orders);
+
+      ORT_ENFORCE(node_orders.size() == num_of_nodes,
+                  "Topological sort failed.", node_orders.size(), "!=", num_of_nodes);
+      nodes_in_mem_efficient_topological_order_ = std::move(node_orders);
+    });
   }
 #endif
 
@@ -321,10 +321,23 @@ const std::vector<NodeIndex>& GraphViewer::GetNodesInTopologicalOrder(ExecutionO
       ORT_THROW("Priority based topological order is not enabled for ORT minimal build.");
 #endif
     case ExecutionOrder::MEMORY_EFFICIENT:
+#if !defined(ORT_MINIMAL_BUILD)
+      std::call_once(mem_efficient_order_flag_, [this]() {
 #ifdef ENABLE_TRAINING
+        // training graphs without a YieldOp keep using the default order
+        nodes_in_mem_efficient_topological_order_ = nodes_in_topological_order_;
+#else
+        std::vector<NodeIndex> node_orders;
+        graph_->MemoryAwareTopologicalSort(node_orders);
+        nodes_in_mem_efficient_topological_order_.reserve(NumberOfNodes());
+        std::copy_if(node_orders.cbegin(), node_orders.cend(),
+                     std::back_inserter(nodes_in_mem_efficient_topological_order_),
+                     [this](NodeIndex idx) { return !filter_info_ || filtered_node_indices_.count(idx) != 0; });
+#endif
+      });
       return nodes_in_mem_efficient_topological_order_;
 #else
-      ORT_THROW("Memory efficient topological order is not enabled for non-training build.");
+      ORT_THROW("Memory efficient topological order is not enabled for ORT minimal build.");
 #endif
     default:
       ORT_THROW("Invalid ExecutionOrder");
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
 #include "core/common/logging/logging.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
@@ -348,6 +349,25 @@ void Model::SetDocString(const std::string& doc_string) {
   model_proto_.set_doc_string(doc_string);
 }
 
+void Model::SetMetaDataEntry(const std::string& key, const std::string& value) {
+  RemoveMetaDataEntry(key);
+  model_metadata_[key] = value;
+  const gsl::not_null<StringStringEntryProto*> prop{model_proto_.add_metadata_props()};
+  prop->set_key(key);
+  prop->set_value(value);
+}
+
+void Model::RemoveMetaDataEntry(const std::string& key) {
+  if (model_metadata_.erase(key) == 0) {
+    return;
+  }
+
+  auto* props = model_proto_.mutable_metadata_props();
+  props->erase(std::remove_if(props->begin(), props->end(),
+                              [&key](const StringStringEntryProto& prop) { return prop.key() == key; }),
+               props->end());
+}
+
 const std::string Model::GraphDocString() const {
   if (model_proto_.has_graph() && model_proto_.graph().has_doc_string()) {
     return model_proto_.graph().doc_string();
@@ -151,6 +151,11 @@ class Model {
   // Set models' doc string.
   void SetDocString(const std::string& doc_string);
 
+  // Add or replace an entry of the model's metadata_props.
+  void SetMetaDataEntry(const std::string& key, const std::string& value);
+  // Remove an entry of the model's metadata_props. Does nothing if there is no entry with the key.
+  void RemoveMetaDataEntry(const std::string& key);
+
   // Get graph's doc string.
   // Returns empty string if not specified.
   const std::string GraphDocString() const;
@@ -0,0 +1,987 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/graph/symbolic_shape_inference.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+#include "onnx/defs/tensor_proto_util.h"
+
+#include "core/common/common.h"
+#include "core/common/safeint.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+SymbolicDimExpr::SymbolicDimExpr(int64_t value) {
+  AddTerm({}, value);
+}
+
+SymbolicDimExpr SymbolicDimExpr::Symbol(std::string name) {
+  SymbolicDimExpr expr;
+  expr.AddTerm({std::move(name)}, 1);
+  return expr;
+}
+
+void SymbolicDimExpr::AddTerm(const Monomial& monomial, int64_t coefficient) {
+  if (coefficient == 0) {
+    return;
+  }
+
+  auto it = terms_.find(monomial);
+  if (it == terms_.end()) {
+    terms_.emplace(monomial, coefficient);
+  } else if (!SafeAdd(it->second, coefficient, it->second)) {
+    overflow_ = true;
+  } else if (it->second == 0) {
+    terms_.erase(it);
+  }
+}
+
+namespace {
+
+// Recursive descent parser for the expressions SymbolicDimExpr::ToString produces:
+//   expr   := ['-'] term (('+' | '-') term)*
+//   term   := factor ('*' factor)*
+//   factor := integer | symbol | '(' expr ')'
+// A symbol is a run of characters other than whitespace, operators and parentheses that does not start
+// with a digit.
+class DimParamParser {
+ public:
+  explicit DimParamParser(std::string_view text) : text_(text) {}
+
+  std::optional<SymbolicDimExpr> Parse() {
+    auto expr = ParseExpr();
+    SkipSpaces();
+    if (!expr || pos_ != text_.size()) {
+      return std::nullopt;
+    }
+
+    return expr;
+  }
+
+ private:
+  static bool IsOperator(char c) {
+    return c == '+' || c == '-' || c == '*' || c == '(' || c == ')';
+  }
+
+  void SkipSpaces() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipSpaces();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+
+    return false;
+  }
+
+  std::optional<SymbolicDimExpr> ParseExpr() {
+    bool negate = Consume('-');
+    auto result = ParseTerm();
+    if (!result) {
+      return std::nullopt;
+    }
+
+    if (negate) {
+      result = SymbolicDimExpr(0) - *result;
+    }
+
+    while (true) {
+      bool add = Consume('+');
+      if (!add && !Consume('-')) {
+        break;
+      }
+
+      auto term = ParseTerm();
+      if (!term) {
+        return std::nullopt;
+      }
+
+      result = add ? *result + *term : *result - *term;
+    }
+
+    return result;
+  }
+
+  std::optional<SymbolicDimExpr> ParseTerm() {
+    auto result = ParseFactor();
+    while (result && Consume('*')) {
+      auto factor = ParseFactor();
+      if (!factor) {
+        return std::nullopt;
+      }
+
+      result = *result * *factor;
+    }
+
+    return result;
+  }
+
+  std::optional<SymbolicDimExpr> ParseFactor() {
+    if (Consume('(')) {
+      auto expr = ParseExpr();
+      if (!expr || !Consume(')')) {
+        return std::nullopt;
+      }
+
+      return expr;
+    }
+
+    SkipSpaces();
+    size_t start = pos_;
+    while (pos_ < text_.size() && !std::isspace(static_cast<unsigned char>(text_[pos_])) &&
+           !IsOperator(text_[pos_])) {
+      ++pos_;
+    }
+
+    if (start == pos_) {
+      return std::nullopt;
+    }
+
+    std::string_view token = text_.substr(start, pos_ - start);
+    if (!std::isdigit(static_cast<unsigned char>(token[0]))) {
+      return SymbolicDimExpr::Symbol(std::string(token));
+    }
+
+    if (token.size() > 18 || !std::all_of(token.begin(), token.end(),
+                                          [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+      return std::nullopt;
+    }
+
+    return SymbolicDimExpr(static_cast<int64_t>(std::stoll(std::string(token))));
+  }
+
+  std::string_view text_;
+  size_t pos_ = 0;
+};
+
+}  // namespace
+
+SymbolicDimExpr SymbolicDimExpr::Parse(std::string_view dim_param) {
+  auto expr = DimParamParser(dim_param).Parse();
+  return expr ? *expr : Symbol(std::string(dim_param));
+}
+
+std::optional<SymbolicDimExpr> SymbolicDimExpr::FromDimension(const TensorShapeProto_Dimension& dim) {
+  if (utils::HasDimValue(dim)) {
+    return SymbolicDimExpr(dim.dim_value());
+  }
+
+  if (utils::HasDimParam(dim) && !dim.dim_param().empty()) {
+    // only read a dim_param as an expression if it is in the form ToString writes, i.e. it came from this inference.
+    // any other name from the model, e.g. "batch-size", stays an opaque symbol with its exact name, so it still
+    // matches the dims of the tensors it came from.
+    const auto& dim_param = dim.dim_param();
+    auto expr = Parse(dim_param);
+    if (!expr.IsValid() || expr.ToString() != dim_param) {
+      return Symbol(dim_param);
+    }
+
+    return expr;
+  }
+
+  return std::nullopt;
+}
+
+void SymbolicDimExpr::ToDimension(TensorShapeProto_Dimension& dim) const {
+  auto value = ConstantValue();
+  if (value.has_value()) {
+    dim.set_dim_value(*value);
+  } else {
+    dim.set_dim_param(ToString());
+  }
+}
+
+std::string SymbolicDimExpr::ToString() const {
+  if (terms_.empty()) {
+    return "0";
+  }
+
+  std::string result;
+
+  auto append_term = [&result](const Monomial& monomial, int64_t coefficient) {
+    if (result.empty()) {
+      if (coefficient < 0) {
+        result += "-";
+      }
+    } else {
+      result += coefficient < 0 ? " - " : " + ";
+    }
+
+    // avoid negating INT64_MIN
+    uint64_t magnitude = coefficient < 0 ? 0 - static_cast<uint64_t>(coefficient) : static_cast<uint64_t>(coefficient);
+    bool first_factor = true;
+    if (magnitude != 1 || monomial.empty()) {
+      result += std::to_string(magnitude);
+      first_factor = false;
+    }
+
+    for (const auto& symbol : monomial) {
+      if (!first_factor) {
+        result += "*";
+      }
+
+      result += symbol;
+      first_factor = false;
+    }
+  };
+
+  // the constant term has the empty monomial so it sorts first. write it last, e.g. `seq_len + 1`.
+  for (const auto& [monomial, coefficient] : terms_) {
+    if (!monomial.empty()) {
+      append_term(monomial, coefficient);
+    }
+  }
+
+  auto constant = terms_.find(Monomial{});
+  if (constant != terms_.end()) {
+    append_term(constant->first, constant->second);
+  }
+
+  return result;
+}
+
+bool SymbolicDimExpr::IsConstant() const {
+  return IsValid() && (terms_.empty() || (terms_.size() == 1 && terms_.begin()->first.empty()));
+}
+
+std::optional<int64_t> SymbolicDimExpr::ConstantValue() const {
+  if (!IsConstant()) {
+    return std::nullopt;
+  }
+
+  return terms_.empty() ? 0 : terms_.begin()->second;
+}
+
+SymbolicDimExpr SymbolicDimExpr::operator+(const SymbolicDimExpr& other) const {
+  SymbolicDimExpr result = *this;
+  result.overflow_ = overflow_ || other.overflow_;
+  for (const auto& [monomial, coefficient] : other.terms_) {
+    result.AddTerm(monomial, coefficient);
+  }
+
+  return result;
+}
+
+SymbolicDimExpr SymbolicDimExpr::operator-(const SymbolicDimExpr& other) const {
+  SymbolicDimExpr result = *this;
+  result.overflow_ = overflow_ || other.overflow_;
+  for (const auto& [monomial, coefficient] : other.terms_) {
+    if (coefficient == std::numeric_limits<int64_t>::min()) {
+      result.overflow_ = true;
+    } else {
+      result.AddTerm(monomial, -coefficient);
+    }
+  }
+
+  return result;
+}
+
+SymbolicDimExpr SymbolicDimExpr::operator*(const SymbolicDimExpr& other) const {
+  SymbolicDimExpr result;
+  result.overflow_ = overflow_ || other.overflow_;
+  for (const auto& [lhs_monomial, lhs_coefficient] : terms_) {
+    for (const auto& [rhs_monomial, rhs_coefficient] : other.terms_) {
+      int64_t coefficient = 0;
+      if (!SafeMultiply(lhs_coefficient, rhs_coefficient, coefficient)) {
+        result.overflow_ = true;
+        continue;
+      }
+
+      Monomial monomial;
+      monomial.reserve(lhs_monomial.size() + rhs_monomial.size());
+      std::merge(lhs_monomial.begin(), lhs_monomial.end(), rhs_monomial.begin(), rhs_monomial.end(),
+                 std::back_inserter(monomial));
+      result.AddTerm(monomial, coefficient);
+    }
+  }
+
+  return result;
+}
+
+std::optional<SymbolicDimExpr> SymbolicDimExpr::DivideExact(const SymbolicDimExpr& divisor) const {
+  if (!IsValid() || !divisor.IsValid() || divisor.terms_.empty()) {
+    return std::nullopt;
+  }
+
+  // divide term by term by a single term divisor such as `4` or `2*num_heads`.
+  auto divide_by_term = [](const SymbolicDimExpr& dividend, const Monomial& divisor_monomial,
+                           int64_t divisor_coefficient) -> std::optional<SymbolicDimExpr> {
+    SymbolicDimExpr result;
+    for (const auto& [monomial, coefficient] : dividend.terms_) {
+      if ((divisor_coefficient == -1 && coefficient == std::numeric_limits<int64_t>::min()) ||
+          coefficient % divisor_coefficient != 0 ||
+          !std::includes(monomial.begin(), monomial.end(), divisor_monomial.begin(), divisor_monomial.end())) {
+        return std::nullopt;
+      }
+
+      Monomial quotient;
+      std::set_difference(monomial.begin(), monomial.end(), divisor_monomial.begin(), divisor_monomial.end(),
+                          std::back_inserter(quotient));
+      result.AddTerm(quotient, coefficient / divisor_coefficient);
+    }
+
+    return result;
+  };
+
+  const auto& [divisor_monomial, divisor_coefficient] = *divisor.terms_.begin();
+  if (divisor.terms_.size() == 1) {
+    return divide_by_term(*this, divisor_monomial, divisor_coefficient);
+  }
+
+  // for a divisor such as `4*past_len + 4*seq_len` only single term quotients are found. each term of this
+  // expression divided by the first divisor term is a candidate, and is verified by multiplying back.
+  for (const auto& [monomial, coefficient] : terms_) {
+    SymbolicDimExpr term;
+    term.AddTerm(monomial, coefficient);
+    auto quotient = divide_by_term(term, divisor_monomial, divisor_coefficient);
+    if (quotient && *quotient * divisor == *this) {
+      return quotient;
+    }
+  }
+
+  return std::nullopt;
+}
+
+namespace symbolic_shape_inference {
+
+namespace {
+
+// Symbolic values are only tracked for small tensors that describe shapes.
+constexpr int64_t kMaxSymbolicDataElements = 64;
+// Larger expressions are dropped rather than written to dim_param.
+constexpr size_t kMaxExpressionTerms = 8;
+
+using SymbolicValues = std::vector<std::optional<SymbolicDimExpr>>;
+
+const NodeArg* GetInputDef(const Node& node, size_t index) {
+  const auto& input_defs = node.InputDefs();
+  if (index >= input_defs.size() || !input_defs[index]->Exists()) {
+    return nullptr;
+  }
+
+  return input_defs[index];
+}
+
+const TensorShapeProto* GetInputShape(const Node& node, size_t index) {
+  const auto* input_def = GetInputDef(node, index);
+  return input_def != nullptr ? input_def->Shape() : nullptr;
+}
+
+std::optional<int64_t> GetIntAttribute(const Node& node, const std::string& name) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  if (it == attributes.end() || it->second.type() != AttributeProto_AttributeType_INT) {
+    return std::nullopt;
+  }
+
+  return it->second.i();
+}
+
+// Reads a small int32 or int64 constant initializer of rank 0 or 1.
+std::optional<std::vector<int64_t>> GetConstantInts(const Node& node, const Graph& graph, size_t index) {
+  const auto* input_def = GetInputDef(node, index);
+  if (input_def == nullptr) {
+    return std::nullopt;
+  }
+
+  const auto* initializer = graph.GetConstantInitializer(input_def->Name(), true);
+  if (initializer == nullptr || utils::HasExternalData(*initializer) || initializer->dims_size() > 1 ||
+      (initializer->dims_size() == 1 && initializer->dims(0) > kMaxSymbolicDataElements)) {
+    return std::nullopt;
+  }
+
+  if (initializer->data_type() == TensorProto_DataType_INT64) {
+    return ParseData<int64_t>(initializer);
+  }
+
+  if (initializer->data_type() == TensorProto_DataType_INT32) {
+    auto values = ParseData<int32_t>(initializer);
+    return std::vector<int64_t>(values.begin(), values.end());
+  }
+
+  return std::nullopt;
+}
+
+SymbolicValues ToSymbolicValues(const TensorShapeProto& data) {
+  SymbolicValues values;
+  values.reserve(data.dim_size());
+  for (const auto& dim : data.dim()) {
+    values.push_back(SymbolicDimExpr::FromDimension(dim));
+  }
+
+  return values;
+}
+
+// Gets the symbolic value of an input from the values propagated so far, or from a constant initializer.
+std::optional<SymbolicValues> GetSymbolicValues(const Node& node, const Graph& graph,
+                                                const SymbolicDataMap& symbolic_data, size_t index) {
+  const auto* input_def = GetInputDef(node, index);
+  if (input_def == nullptr) {
+    return std::nullopt;
+  }
+
+  auto it = symbolic_data.find(input_def->Name());
+  if (it != symbolic_data.end()) {
+    return ToSymbolicValues(it->second);
+  }
+
+  auto constant = GetConstantInts(node, graph, index);
+  if (!constant) {
+    return std::nullopt;
+  }
+
+  SymbolicValues values;
+  values.reserve(constant->size());
+  for (int64_t value : *constant) {
+    values.emplace_back(SymbolicDimExpr(value));
+  }
+
+  return values;
+}
+
+std::optional<SymbolicDimExpr> GetDim(const TensorShapeProto& shape, int index) {
+  return SymbolicDimExpr::FromDimension(shape.dim(index));
+}
+
+std::optional<SymbolicDimExpr> Product(const TensorShapeProto& shape) {
+  SymbolicDimExpr product(1);
+  for (const auto& dim : shape.dim()) {
+    auto expr = SymbolicDimExpr::FromDimension(dim);
+    if (!expr) {
+      return std::nullopt;
+    }
+
+    product = product * *expr;
+  }
+
+  return product;
+}
+
+bool IsConstant(const std::optional<SymbolicDimExpr>& expr, int64_t value) {
+  return expr.has_value() && expr->ConstantValue() == value;
+}
+
+void SetIfUnknown(TensorShapeProto_Dimension& dim, const std::optional<SymbolicDimExpr>& expr) {
+  if (utils::HasDimValue(dim) || (utils::HasDimParam(dim) && !dim.dim_param().empty()) || !expr ||
+      !expr->IsValid() || expr->NumTerms() > kMaxExpressionTerms) {
+    return;
+  }
+
+  expr->ToDimension(dim);
+}
+
+// Returns the shape of a tensor output, adding one of the given rank if ONNX inferred the type but no shape.
+// Returns nullptr if the output is not a tensor or its rank does not match.
+TensorShapeProto* GetMutableOutputShape(std::vector<TypeProto>& output_types, size_t index, int rank) {
+  if (index >= output_types.size() || !utils::HasTensorType(output_types[index])) {
+    return nullptr;
+  }
+
+  auto& tensor_type = *output_types[index].mutable_tensor_type();
+  if (!tensor_type.has_shape()) {
+    for (int i = 0; i < rank; ++i) {
+      tensor_type.mutable_shape()->add_dim();
+    }
+  }
+
+  auto* shape = tensor_type.mutable_shape();
+  return shape->dim_size() == rank ? shape : nullptr;
+}
+
+void SetOutputDims(std::vector<TypeProto>& output_types, const SymbolicValues& dims) {
+  auto* output_shape = GetMutableOutputShape(output_types, 0, static_cast<int>(dims.size()));
+  if (output_shape == nullptr) {
+    return;
+  }
+
+  for (int i = 0; i < output_shape->dim_size(); ++i) {
+    SetIfUnknown(*output_shape->mutable_dim(i), dims[i]);
+  }
+}
+
+void RefineConcat(const Node& node, std::vector<TypeProto>& output_types) {
+  const auto* first_shape = GetInputShape(node, 0);
+  auto axis = GetIntAttribute(node, "axis");
+  if (first_shape == nullptr || !axis) {
+    return;
+  }
+
+  const int rank = first_shape->dim_size();
+  if (*axis < -rank || *axis >= rank) {
+    return;
+  }
+
+  const int normalized_axis = static_cast<int>(*axis < 0 ? *axis + rank : *axis);
+
+  std::optional<SymbolicDimExpr> sum = SymbolicDimExpr(0);
+  for (size_t i = 0; i < node.InputDefs().size() && sum; ++i) {
+    const auto* shape = GetInputShape(node, i);
+    if (shape == nullptr || shape->dim_size() != rank) {
+      return;
+    }
+
+    auto dim = GetDim(*shape, normalized_axis);
+    sum = dim ? std::optional<SymbolicDimExpr>(*sum + *dim) : std::nullopt;
+  }
+
+  auto* output_shape = GetMutableOutputShape(output_types, 0, rank);
+  if (output_shape != nullptr) {
+    SetIfUnknown(*output_shape->mutable_dim(normalized_axis), sum);
+  }
+}
+
+void RefineReshape(const Node& node, const Graph& graph, const SymbolicDataMap& symbolic_data,
+                   std::vector<TypeProto>& output_types) {
+  auto target = GetSymbolicValues(node, graph, symbolic_data, 1);
+  if (!target) {
+    return;
+  }
+
+  const auto* input_shape = GetInputShape(node, 0);
+  const bool allow_zero = GetIntAttribute(node, "allowzero").value_or(0) != 0;
+
+  SymbolicValues dims = *target;
+  std::optional<size_t> inferred_index;
+  std::optional<SymbolicDimExpr> known_product = SymbolicDimExpr(1);
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (IsConstant(dims[i], 0) && !allow_zero) {
+      dims[i] = (input_shape != nullptr && static_cast<int>(i) < input_shape->dim_size())
+                    ? GetDim(*input_shape, static_cast<int>(i))
+                    : std::nullopt;
+    } else if (IsConstant(dims[i], -1)) {
+      dims[i] = std::nullopt;
+      inferred_index = i;
+      continue;
+    }
+
+    known_product = (known_product && dims[i]) ? std::optional<SymbolicDimExpr>(*known_product * *dims[i])
+                                               : std::nullopt;
+  }
+
+  if (inferred_index && known_product && input_shape != nullptr) {
+    auto total = Product(*input_shape);
+    if (total) {
+      dims[*inferred_index] = total->DivideExact(*known_product);
+    }
+  }
+
+  SetOutputDims(output_types, dims);
+}
+
+void RefineExpand(const Node& node, const Graph& graph, const SymbolicDataMap& symbolic_data,
+                  std::vector<TypeProto>& output_types) {
+  const auto* input_shape = GetInputShape(node, 0);
+  auto target = GetSymbolicValues(node, graph, symbolic_data, 1);
+  if (input_shape == nullptr || !target) {
+    return;
+  }
+
+  const int input_rank = input_shape->dim_size();
+  const int target_rank = static_cast<int>(target->size());
+  const int rank = std::max(input_rank, target_rank);
+
+  SymbolicValues dims(rank);
+  for (int i = 0; i < rank; ++i) {
+    const int input_index = i - (rank - input_rank);
+    const int target_index = i - (rank - target_rank);
+    auto input_dim = input_index >= 0 ? GetDim(*input_shape, input_index) : SymbolicDimExpr(1);
+    auto target_dim = target_index >= 0 ? (*target)[target_index] : SymbolicDimExpr(1);
+
+    if (IsConstant(input_dim, 1)) {
+      dims[i] = target_dim;
+    } else if (IsConstant(target_dim, 1) || input_dim == target_dim) {
+      dims[i] = input_dim;
+    }
+  }
+
+  SetOutputDims(output_types, dims);
+}
+
+void RefineSlice(const Node& node, const Graph& graph, std::vector<TypeProto>& output_types) {
+  const auto* input_shape = GetInputShape(node, 0);
+  auto starts = GetConstantInts(node, graph, 1);
+  auto ends = GetConstantInts(node, graph, 2);
+  if (input_shape == nullptr || !starts || !ends || starts->size() != ends->size()) {
+    return;
+  }
+
+  const int rank = input_shape->dim_size();
+  std::vector<int64_t> axes(starts->size());
+  std::iota(axes.begin(), axes.end(), int64_t{0});
+  if (GetInputDef(node, 3) != nullptr) {
+    auto constant_axes = GetConstantInts(node, graph, 3);
+    if (!constant_axes || constant_axes->size() != starts->size()) {
+      return;
+    }
+
+    axes = *constant_axes;
+  }
+
+  std::optional<std::vector<int64_t>> steps;
+  if (GetInputDef(node, 4) != nullptr) {
+    steps = GetConstantInts(node, graph, 4);
+    if (!steps || steps->size() != starts->size()) {
+      return;
+    }
+  }
+
+  auto* output_shape = GetMutableOutputShape(output_types, 0, rank);
+  if (output_shape == nullptr) {
+    return;
+  }
+
+  for (size_t i = 0; i < axes.size(); ++i) {
+    const int64_t axis = axes[i] < 0 ? axes[i] + rank : axes[i];
+    if (axis < 0 || axis >= rank || (steps && (*steps)[i] != 1)) {
+      continue;
+    }
+
+    auto dim = GetDim(*input_shape, static_cast<int>(axis));
+    if (!dim) {
+      continue;
+    }
+
+    const int64_t start = (*starts)[i];
+    const int64_t end = (*ends)[i];
+    auto dim_value = dim->ConstantValue();
+    if (dim_value) {
+      // the bounds are known, so clamp them the way Slice does.
+      auto clamp = [size = *dim_value](int64_t index) {
+        return std::clamp<int64_t>(index < 0 ? index + size : index, 0, size);
+      };
+
+      const int64_t length = clamp(end) - clamp(start);
+      if (length > 0) {
+        SetIfUnknown(*output_shape->mutable_dim(static_cast<int>(axis)), SymbolicDimExpr(length));
+      }
+
+      continue;
+    }
+
+    // A symbolic dim cannot be clamped, so only the common forms are handled: a start that counts from
+    // either end, and an end that is either past the last element or counts from the back. The start is
+    // assumed to be within the dim.
+    SymbolicDimExpr start_expr = start < 0 ? *dim + SymbolicDimExpr(start) : SymbolicDimExpr(start);
+    std::optional<SymbolicDimExpr> end_expr;
+    if (end >= std::numeric_limits<int32_t>::max()) {
+      end_expr = *dim;
+    } else if (end < 0) {
+      end_expr = *dim + SymbolicDimExpr(end);
+    }
+
+    if (!end_expr) {
+      continue;
+    }
+
+    // when the dim cancels out, e.g. for starts=-5 and ends=-1, the length is only right if the dim is at least
+    // as large as the start offset, which a symbolic dim does not guarantee. a symbolic length carries the same
+    // assumption, but is never a wrong constant that later shape checks or the allocation planner would trust.
+    auto length = *end_expr - start_expr;
+    if (length.IsConstant()) {
+      continue;
+    }
+
+    SetIfUnknown(*output_shape->mutable_dim(static_cast<int>(axis)), length);
+  }
+}
+
+void RefineRange(const Node& node, const Graph& graph, const SymbolicDataMap& symbolic_data,
+                 std::vector<TypeProto>& output_types) {
+  auto start = GetSymbolicValues(node, graph, symbolic_data, 0);
+  auto limit = GetSymbolicValues(node, graph, symbolic_data, 1);
+  auto delta = GetSymbolicValues(node, graph, symbolic_data, 2);
+  if (!start || !limit || !delta || start->size() != 1 || limit->size() != 1 || delta->size() != 1 ||
+      !(*start)[0] || !(*limit)[0] || !IsConstant((*delta)[0], 1)) {
+    return;
+  }
+
+  // Range produces no elements when limit <= start, so a constant length is clamped at 0 like it is at run time.
+  auto length = *(*limit)[0] - *(*start)[0];
+  auto length_value = length.ConstantValue();
+  if (length_value && *length_value < 0) {
+    length = SymbolicDimExpr(0);
+  }
+
+  SetOutputDims(output_types, {length});
+}
+
+SymbolicValues Broadcast(const SymbolicValues& lhs, const SymbolicValues& rhs) {
+  return lhs.size() == 1 ? SymbolicValues(rhs.size(), lhs[0]) : lhs;
+}
+
+std::optional<SymbolicValues> ComputeBinaryOp(const std::string& op_type, const SymbolicValues& lhs,
+                                              const SymbolicValues& rhs) {
+  if (lhs.size() != rhs.size() && lhs.size() != 1 && rhs.size() != 1) {
+    return std::nullopt;
+  }
+
+  auto broadcast_lhs = Broadcast(lhs, rhs);
+  auto broadcast_rhs = Broadcast(rhs, lhs);
+
+  SymbolicValues result(broadcast_lhs.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    const auto& a = broadcast_lhs[i];
+    const auto& b = broadcast_rhs[i];
+    if (!a || !b) {
+      continue;
+    }
+
+    if (op_type == "Add") {
+      result[i] = *a + *b;
+    } else if (op_type == "Sub") {
+      result[i] = *a - *b;
+    } else if (op_type == "Mul") {
+      result[i] = *a * *b;
+    } else {
+      // integer Div truncates, which matches the exact quotient when there is one.
+      result[i] = a->DivideExact(*b);
+    }
+  }
+
+  return result;
+}
+
+std::optional<SymbolicValues> ComputeSlice(const Node& node, const Graph& graph, const SymbolicValues& data) {
+  auto starts = GetConstantInts(node, graph, 1);
+  auto ends = GetConstantInts(node, graph, 2);
+  if (!starts || !ends || starts->size() != 1 || ends->size() != 1) {
+    return std::nullopt;
+  }
+
+  if (GetInputDef(node, 3) != nullptr) {
+    auto axes = GetConstantInts(node, graph, 3);
+    if (!axes || axes->size() != 1 || ((*axes)[0] != 0 && (*axes)[0] != -1)) {
+      return std::nullopt;
+    }
+  }
+
+  int64_t step = 1;
+  if (GetInputDef(node, 4) != nullptr) {
+    auto steps = GetConstantInts(node, graph, 4);
+    if (!steps || steps->size() != 1 || (*steps)[0] == 0) {
+      return std::nullopt;
+    }
+
+    step = (*steps)[0];
+  }
+
+  const int64_t size = static_cast<int64_t>(data.size());
+  auto clamp = [size, step](int64_t index) {
+    if (index < 0) {
+      index += size;
+    }
+
+    return step > 0 ? std::clamp<int64_t>(index, 0, size) : std::clamp<int64_t>(index, -1, size - 1);
+  };
+
+  SymbolicValues result;
+  for (int64_t i = clamp((*starts)[0]), end = clamp((*ends)[0]); step > 0 ? i < end : i > end; i += step) {
+    result.push_back(data[static_cast<size_t>(i)]);
+  }
+
+  return result;
+}
+
+std::optional<SymbolicValues> ComputeSymbolicData(const Node& node, const Graph& graph,
+                                                  const SymbolicDataMap& symbolic_data) {
+  const auto& op_type = node.OpType();
+
+  if (op_type == "Shape") {
+    const auto* shape = GetInputShape(node, 0);
+    if (shape == nullptr) {
+      return std::nullopt;
+    }
+
+    const int64_t rank = shape->dim_size();
+    auto normalize = [rank](int64_t index) { return std::clamp<int64_t>(index < 0 ? index + rank : index, 0, rank); };
+    const int64_t start = normalize(GetIntAttribute(node, "start").value_or(0));
+    const int64_t end = normalize(GetIntAttribute(node, "end").value_or(rank));
+
+    SymbolicValues result;
+    for (int64_t i = start; i < end; ++i) {
+      result.push_back(GetDim(*shape, static_cast<int>(i)));
+    }
+
+    return result;
+  }
+
+  if (op_type == "Size") {
+    const auto* shape = GetInputShape(node, 0);
+    if (shape == nullptr) {
+      return std::nullopt;
+    }
+
+    return SymbolicValues{Product(*shape)};
+  }
+
+  if (op_type == "Concat") {
+    // the inputs are of rank 1, so only axis 0 (or -1) is valid
+    auto axis = GetIntAttribute(node, "axis");
+    if (!axis || (*axis != 0 && *axis != -1)) {
+      return std::nullopt;
+    }
+
+    SymbolicValues result;
+    for (size_t i = 0; i < node.InputDefs().size(); ++i) {
+      auto values = GetSymbolicValues(node, graph, symbolic_data, i);
+      if (!values) {
+        return std::nullopt;
+      }
+
+      result.insert(result.end(), values->begin(), values->end());
+    }
+
+    return result;
+  }
+
+  auto data = GetSymbolicValues(node, graph, symbolic_data, 0);
+  if (!data) {
+    return std::nullopt;
+  }
+
+  // the values are unchanged when the output is of rank 0 or 1, which PropagateSymbolicData checks
+  if (op_type == "Identity" || op_type == "Squeeze" || op_type == "Unsqueeze") {
+    return data;
+  }
+
+  if (op_type == "Cast") {
+    auto to = GetIntAttribute(node, "to");
+    if (to == TensorProto_DataType_INT64 || to == TensorProto_DataType_INT32) {
+      return data;
+    }
+
+    return std::nullopt;
+  }
+
+  if (op_type == "Gather") {
+    auto indices = GetConstantInts(node, graph, 1);
+    if (!indices || GetIntAttribute(node, "axis").value_or(0) != 0) {
+      return std::nullopt;
+    }
+
+    const int64_t size = static_cast<int64_t>(data->size());
+    SymbolicValues result;
+    for (int64_t index : *indices) {
+      if (index < -size || index >= size) {
+        return std::nullopt;
+      }
+
+      result.push_back((*data)[static_cast<size_t>(index < 0 ? index + size : index)]);
+    }
+
+    return result;
+  }
+
+  if (op_type == "Slice") {
+    return ComputeSlice(node, graph, *data);
+  }
+
+  if (op_type == "Add" || op_type == "Sub" || op_type == "Mul" || op_type == "Div") {
+    auto rhs = GetSymbolicValues(node, graph, symbolic_data, 1);
+    if (!rhs) {
+      return std::nullopt;
+    }
+
+    return ComputeBinaryOp(op_type, *data, *rhs);
+  }
+
+  return std::nullopt;
+}
+
+// Returns the rank of the first output as inferred so far, or -1 if it is not known.
+int GetOutputRank(const Node& node, const std::vector<TypeProto>& output_types) {
+  if (!output_types.empty() && utils::HasTensorType(output_types[0]) && utils::HasShape(output_types[0])) {
+    return output_types[0].tensor_type().shape().dim_size();
+  }
+
+  const auto* shape = node.OutputDefs()[0]->Shape();
+  return shape != nullptr ? shape->dim_size() : -1;
+}
+
+bool IsOnnxDomain(const Node& node) {
+  return node.Domain() == kOnnxDomain || node.Domain() == kOnnxDomainAlias;
+}
+
+}  // namespace
+
+void RefineOutputShapes(const Node& node, const Graph& graph, const SymbolicDataMap& symbolic_data,
+                        std::vector<TypeProto>& output_types) {
+  if (!IsOnnxDomain(node) || output_types.empty()) {
+    return;
+  }
+
+  const auto& op_type = node.OpType();
+  if (op_type == "Concat") {
+    RefineConcat(node, output_types);
+  } else if (op_type == "Reshape") {
+    RefineReshape(node, graph, symbolic_data, output_types);
+  } else if (op_type == "Expand") {
+    RefineExpand(node, graph, symbolic_data, output_types);
+  } else if (op_type == "ConstantOfShape") {
+    auto dims = GetSymbolicValues(node, graph, symbolic_data, 0);
+    if (dims) {
+      SetOutputDims(output_types, *dims);
+    }
+  } else if (op_type == "Slice" && node.SinceVersion() >= 10) {
+    RefineSlice(node, graph, output_types);
+  } else if (op_type == "Range") {
+    RefineRange(node, graph, symbolic_data, output_types);
+  }
+}
+
+void PropagateSymbolicData(const Node& node, const Graph& graph, const std::vector<TypeProto>& output_types,
+                           SymbolicDataMap& symbolic_data) {
+  if (!IsOnnxDomain(node) || node.OutputDefs().empty() || !node.OutputDefs()[0]->Exists()) {
+    return;
+  }
+
+  // the values are stored as a flat list, which only describes tensors of rank 0 or 1. e.g. an Unsqueeze to
+  // [1, n] or a broadcast to rank 2 are not tracked.
+  const int output_rank = GetOutputRank(node, output_types);
+  if (output_rank < 0 || output_rank > 1) {
+    return;
+  }
+
+  // Slice takes starts and ends as attributes before opset 10.
+  if (node.OpType() == "Slice" && node.SinceVersion() < 10) {
+    return;
+  }
+
+  auto values = ComputeSymbolicData(node, graph, symbolic_data);
+  if (!values || values->size() > static_cast<size_t>(kMaxSymbolicDataElements) ||
+      std::none_of(values->begin(), values->end(), [](const auto& value) { return value.has_value(); })) {
+    return;
+  }
+
+  TensorShapeProto data;
+  for (const auto& value : *values) {
+    auto* dim = data.add_dim();
+    if (value && value->IsValid() && value->NumTerms() <= kMaxExpressionTerms) {
+      value->ToDimension(*dim);
+    }
+  }
+
+  symbolic_data[node.OutputDefs()[0]->Name()] = std::move(data);
+}
+
+}  // namespace symbolic_shape_inference
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+class Graph;
+class Node;
+
+/**
+ * A tensor dimension expressed as a polynomial with integer coefficients over named symbolic dimensions,
+ * e.g. `past_len + seq_len` or `2*batch*num_heads`.
+ *
+ * The canonical string form is what gets written to TensorShapeProto dim_param, so two dimensions that are
+ * derived from the same symbols by equivalent arithmetic end up with identical dim_param values. Consumers such
+ * as the allocation planner, which compare dim_param strings, can therefore treat them as equal sizes.
+ *
+ * A dim_param that is not an expression in this canonical form (e.g. "batch size" or "batch-size") is treated as a
+ * single opaque symbol, so names from the model are never reinterpreted as arithmetic.
+ */
+class SymbolicDimExpr {
+ public:
+  SymbolicDimExpr() = default;
+  explicit SymbolicDimExpr(int64_t value);
+
+  static SymbolicDimExpr Symbol(std::string name);
+
+  // Parses a dim_param. Anything that does not parse as an expression is an opaque symbol.
+  static SymbolicDimExpr Parse(std::string_view dim_param);
+
+  // Returns std::nullopt for a dimension that has neither a value nor a param. A dim_param that is not in the
+  // canonical form of ToString is an opaque symbol.
+  static std::optional<SymbolicDimExpr> FromDimension(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim);
+
+  // Sets dim_value if the expression is a constant, and dim_param otherwise.
+  void ToDimension(ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) const;
+
+  std::string ToString() const;
+
+  bool IsConstant() const;
+  std::optional<int64_t> ConstantValue() const;
+
+  // Expressions with many terms are not useful to downstream consumers and are dropped by the inference.
+  size_t NumTerms() const { return terms_.size(); }
+
+  // False if a coefficient overflowed int64 in the arithmetic that produced this expression. An invalid
+  // expression is never constant, never equal to another expression and must not be written to a dimension.
+  bool IsValid() const { return !overflow_; }
+
+  SymbolicDimExpr operator+(const SymbolicDimExpr& other) const;
+  SymbolicDimExpr operator-(const SymbolicDimExpr& other) const;
+  SymbolicDimExpr operator*(const SymbolicDimExpr& other) const;
+
+  // Returns the quotient if `divisor` divides this expression exactly, std::nullopt otherwise.
+  std::optional<SymbolicDimExpr> DivideExact(const SymbolicDimExpr& divisor) const;
+
+  bool operator==(const SymbolicDimExpr& other) const {
+    return IsValid() && other.IsValid() && terms_ == other.terms_;
+  }
+  bool operator!=(const SymbolicDimExpr& other) const { return !(*this == other); }
+
+ private:
+  // A product of symbols, sorted by name. Repeated symbols represent powers. The empty monomial is the
+  // constant term.
+  using Monomial = std::vector<std::string>;
+
+  void AddTerm(const Monomial& monomial, int64_t coefficient);
+
+  // Terms with a zero coefficient are never stored.
+  std::map<Monomial, int64_t> terms_;
+  bool overflow_ = false;
+};
+
+namespace symbolic_shape_inference {
+
+// Symbolic values of small integer tensors such as the output of Shape, keyed by NodeArg name.
+// Each element is stored as a dimension of the TensorShapeProto, matching how ONNX represents the symbolic
+// inputs that InferenceContext::getSymbolicInput returns.
+using SymbolicDataMap = std::unordered_map<std::string, ONNX_NAMESPACE::TensorShapeProto>;
+
+/**
+ * Fills in output dimensions that ONNX shape inference left unknown for `node`, using dimension arithmetic
+ * (e.g. the Concat axis is the sum of the input dims) and the symbolic values in `symbolic_data`.
+ * Dimensions that ONNX inferred are never changed.
+ */
+void RefineOutputShapes(const Node& node, const Graph& graph, const SymbolicDataMap& symbolic_data,
+                        std::vector<ONNX_NAMESPACE::TypeProto>& output_types);
+
+/**
+ * Computes the symbolic values of `node`'s outputs when it operates on shape tensors
+ * (Shape, Gather, Concat, Slice, Unsqueeze, Add, Mul, ...) and records them in `symbolic_data`.
+ * Only outputs that `output_types` shows to be of rank 0 or 1 are tracked.
+ */
+void PropagateSymbolicData(const Node& node, const Graph& graph,
+                           const std::vector<ONNX_NAMESPACE::TypeProto>& output_types,
+                           SymbolicDataMap& symbolic_data);
+
+}  // namespace symbolic_shape_inference
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
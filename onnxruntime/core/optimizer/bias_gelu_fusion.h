@@ -17,6 +17,10 @@ class BiasGeluFusion : public GraphTransformer {
       : GraphTransformer("BiasGeluFusion", compatible_execution_providers) {
   }
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "FastGelu", "Gelu"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
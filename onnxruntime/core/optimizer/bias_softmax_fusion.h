@@ -16,6 +16,10 @@ class BiasSoftmaxFusion : public GraphTransformer {
   BiasSoftmaxFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("BiasSoftmaxFusion", compatible_execution_providers) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Softmax"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <limits>
 
 #include "core/optimizer/constant_folding.h"
@@ -37,16 +38,13 @@ ConstantFolding::ConstantFolding(const std::string& name,
       execution_provider_(execution_provider) {
 }
 
-// We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
-// Shape to be able to be constant folded.
-static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
-  // Opset-15 Shape supports slicing using a 'start' and 'end' attribute
-  const auto& shape_attributes = node.GetAttributes();
-
+// Returns the [start, end) range of the input dims that a Shape node with an input of the given rank outputs.
+// Opset-15 Shape supports slicing using a 'start' and 'end' attribute.
+static std::pair<int64_t, int64_t> GetShapeSliceRange(const Node& shape_node, int64_t rank) {
   int64_t start = 0;
   int64_t end = std::numeric_limits<int64_t>::max();
 
-  for (const auto& attr : shape_attributes) {
+  for (const auto& attr : shape_node.GetAttributes()) {
     if (attr.first == "start") {
       start = attr.second.i();
     } else if (attr.first == "end") {
@@ -54,6 +52,19 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
     }
   }
 
+  // Deal with negatives and clamp
+  start = start < 0 ? start + rank : start;
+  start = start < 0 ? 0 : ((start > rank) ? rank : start);
+
+  end = end < 0 ? end + rank : end;
+  end = end < 0 ? 0 : ((end > rank) ? rank : end);
+
+  return {start, std::max(start, end)};
+}
+
+// We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
+// Shape to be able to be constant folded.
+static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   auto shape = node.MutableInputDefs()[0]->Shape();
   bool is_concrete_shape = true;
   std::vector<int64_t> dim_values;
@@ -74,17 +85,8 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
     int64_t rank = static_cast<int64_t>(dim_values.size());
 
     // We ascertain the "true" starts/ends (if they were provided)
-    // Opset-15 Shape op supports slicing shape values
-
-    // Deal with negatives and clamp
-    start = start < 0 ? start + rank : start;
-    start = start < 0 ? 0 : ((start > rank) ? rank : start);
-
-    end = end < 0 ? end + rank : end;
-    end = end < 0 ? 0 : ((end > rank) ? rank : end);
-
-    int64_t slice_length = end - start;
-    size_t clamped_slice_length = slice_length < 0 ? 0 : static_cast<size_t>(slice_length);
+    const auto [start, end] = GetShapeSliceRange(node, rank);
+    size_t clamped_slice_length = static_cast<size_t>(end - start);
 
     ONNX_NAMESPACE::TensorProto shape_constant;
     auto* constant_arg_out = node.MutableOutputDefs()[0];
@@ -101,6 +103,76 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
   return is_concrete_shape;  // convert to constant if this is true
 }
 
+// Shape -> Gather is how most graphs read a single dimension. When the gathered dims are static the Gather can be
+// folded even if other dims of the Shape input are symbolic, which lets the Concat/Unsqueeze/Reshape shape
+// arithmetic that follows be folded as well.
+static bool ConstantFoldGatherOfShapeNode(Graph& graph, Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13})) {
+    return false;
+  }
+
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr != nullptr && axis_attr->i() != 0 && axis_attr->i() != -1) {
+    return false;
+  }
+
+  const Node* shape_node = graph.GetProducerNode(node.InputDefs()[0]->Name());
+  const auto* indices_tensor = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+  if (shape_node == nullptr || shape_node->OpType() != "Shape" || shape_node->Domain() != kOnnxDomain ||
+      indices_tensor == nullptr) {
+    return false;
+  }
+
+  const auto* shape = shape_node->InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  const auto [start, end] = GetShapeSliceRange(*shape_node, shape->dim_size());
+  const int64_t num_dims = end - start;
+
+  Initializer indices{*indices_tensor, graph.ModelPath()};
+  std::vector<int64_t> dim_values;
+  dim_values.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    int64_t index = 0;
+    if (indices.data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+      index = indices.data<int64_t>()[i];
+    } else if (indices.data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT32) {
+      index = indices.data<int32_t>()[i];
+    } else {
+      return false;
+    }
+
+    index = index < 0 ? index + num_dims : index;
+    if (index < 0 || index >= num_dims) {
+      return false;  // leave it to the kernel to report the error
+    }
+
+    const auto& dim = shape->dim(static_cast<int>(start + index));
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    dim_values.push_back(dim.dim_value());
+  }
+
+  // the output has the shape of the indices as the Shape output is 1D
+  ONNX_NAMESPACE::TensorProto gather_constant;
+  auto* constant_arg_out = node.MutableOutputDefs()[0];
+  gather_constant.set_name(constant_arg_out->Name());
+  gather_constant.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  ONNX_NAMESPACE::TensorShapeProto result_shape;
+  for (const auto dim : indices_tensor->dims()) {
+    gather_constant.add_dims(dim);
+    result_shape.add_dim()->set_dim_value(dim);
+  }
+  utils::SetRawDataInTensorProto(gather_constant, dim_values.data(), dim_values.size() * sizeof(int64_t));
+  constant_arg_out->SetShape(result_shape);
+  graph.AddInitializedTensor(gather_constant);
+
+  return true;
+}
+
 // This function inlines the appropriate subgraph. It does not literally fold it.
 static Status ConstantFoldIfNode(Graph& graph, Node& if_node, const logging::Logger& logger, bool& folded) {
   folded = false;
@@ -183,6 +255,9 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       }
     } else if (node->OpType().compare("Shape") == 0) {
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
+    } else if (graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) &&
+               ConstantFoldGatherOfShapeNode(graph, *node)) {
+      converted_to_constant = true;
     } else {
       InitializedTensorSet constant_inputs;
 
@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsSupportedTableType(const NodeArg& arg) {
+  const auto* type = arg.Type();
+  return type != nullptr && (*type == "tensor(float)" || *type == "tensor(float16)");
+}
+
+bool IsSameDim(const TensorShapeProto_Dimension& lhs, const TensorShapeProto_Dimension& rhs) {
+  if (utils::HasDimValue(lhs) && utils::HasDimValue(rhs)) {
+    return lhs.dim_value() == rhs.dim_value();
+  }
+  return utils::HasDimParam(lhs) && utils::HasDimParam(rhs) && lhs.dim_param() == rhs.dim_param();
+}
+
+// The Mul operand scales each gathered row, so it must be shaped indices_shape + [1]. Anything that broadcasts
+// differently is not a per sample weight.
+bool IsPerSampleWeightShape(const NodeArg& weights, const NodeArg& indices) {
+  const auto* weights_shape = weights.Shape();
+  const auto* indices_shape = indices.Shape();
+  if (weights_shape == nullptr || indices_shape == nullptr ||
+      weights_shape->dim_size() != indices_shape->dim_size() + 1) {
+    return false;
+  }
+
+  const auto& last_dim = weights_shape->dim(weights_shape->dim_size() - 1);
+  if (!utils::HasDimValue(last_dim) || last_dim.dim_value() != 1) {
+    return false;
+  }
+
+  for (int i = 0; i < indices_shape->dim_size(); ++i) {
+    if (!IsSameDim(weights_shape->dim(i), indices_shape->dim(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Axes come from an attribute up to ReduceSum-11/ReduceMean-13 and from a constant input afterwards.
+bool GetSingleReduceAxis(const Graph& graph, const Node& reduce_node, int64_t& axis) {
+  InlinedVector<int64_t> axes;
+  const auto* axes_attr = graph_utils::GetNodeAttribute(reduce_node, "axes");
+  if (axes_attr != nullptr) {
+    axes.assign(axes_attr->ints().begin(), axes_attr->ints().end());
+  } else if (reduce_node.InputDefs().size() > 1 && reduce_node.InputDefs()[1]->Exists()) {
+    if (!optimizer_utils::AppendTensorFromInitializer(graph, *reduce_node.InputDefs()[1], axes, true)) {
+      return false;
+    }
+  }
+
+  if (axes.size() != 1) {
+    return false;
+  }
+  axis = axes[0];
+  return true;
+}
+
+}  // namespace
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // node was removed
+
+    auto& gather_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, gather_node, 1)) {
+      continue;
+    }
+
+    NodeArg* data = gather_node.MutableInputDefs()[0];
+    NodeArg* indices = gather_node.MutableInputDefs()[1];
+    const auto* data_shape = data->Shape();
+    const auto* indices_shape = indices->Shape();
+    if (!IsSupportedTableType(*data) || data_shape == nullptr || data_shape->dim_size() != 2 ||
+        indices_shape == nullptr || indices_shape->dim_size() < 1) {
+      continue;
+    }
+
+    const auto* axis_attr = graph_utils::GetNodeAttribute(gather_node, "axis");
+    const int64_t gather_axis = axis_attr != nullptr ? axis_attr->i() : 0;
+    if (gather_axis != 0 && gather_axis != -2) {
+      continue;
+    }
+
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse{gather_node};
+    const auto& provider = gather_node.GetExecutionProviderType();
+
+    Node* next_node = graph.GetNode(gather_node.OutputNodesBegin()->Index());
+    NodeArg* per_sample_weights = nullptr;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Mul", {7, 13, 14}) &&
+        next_node->GetExecutionProviderType() == provider &&
+        optimizer_utils::CheckOutputEdges(graph, *next_node, 1)) {
+      Node& mul_node = *next_node;
+      const NodeArg* gather_out = gather_node.OutputDefs()[0];
+      const int weights_index = mul_node.InputDefs()[0] == gather_out ? 1 : 0;
+      per_sample_weights = mul_node.MutableInputDefs()[weights_index];
+      // squaring the gathered rows is not a weighting, even when the embedding dim is 1 and the shapes would match
+      if (per_sample_weights == gather_out || !IsPerSampleWeightShape(*per_sample_weights, *indices)) {
+        continue;
+      }
+      nodes_to_fuse.push_back(mul_node);
+      next_node = graph.GetNode(mul_node.OutputNodesBegin()->Index());
+    }
+
+    Node& reduce_node = *next_node;
+    bool mean = false;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13, 18})) {
+      mean = true;
+    } else if (!graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13})) {
+      continue;
+    }
+
+    if (reduce_node.GetExecutionProviderType() != provider ||
+        !optimizer_utils::IsAttributeWithExpectedValue(reduce_node, "keepdims", static_cast<int64_t>(0))) {
+      continue;
+    }
+
+    // The gathered tensor is indices_shape + [embedding_dim] and the bag is the last indices dimension.
+    const int64_t gathered_rank = indices_shape->dim_size() + 1;
+    int64_t reduce_axis = 0;
+    if (!GetSingleReduceAxis(graph, reduce_node, reduce_axis)) {
+      continue;
+    }
+    reduce_axis = reduce_axis < 0 ? reduce_axis + gathered_rank : reduce_axis;
+    if (reduce_axis != gathered_rank - 2) {
+      continue;
+    }
+
+    // ReduceMean of an empty bag is NaN but EmbeddingBag returns 0 for it, so only fuse a mean over bags that are
+    // known to be non-empty.
+    if (mean) {
+      const auto& bag_dim = indices_shape->dim(indices_shape->dim_size() - 1);
+      if (!utils::HasDimValue(bag_dim) || bag_dim.dim_value() <= 0) {
+        continue;
+      }
+    }
+    nodes_to_fuse.push_back(reduce_node);
+
+    InlinedVector<NodeArg*> fused_inputs{data, indices};
+    if (per_sample_weights != nullptr) {
+      fused_inputs.push_back(&graph.GetOrCreateNodeArg("", nullptr));  // no offsets
+      fused_inputs.push_back(per_sample_weights);
+    }
+
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                             "EmbeddingBag",
+                                             "fused " + gather_node.Name() + " and " + reduce_node.Name(),
+                                             fused_inputs,
+                                             {},
+                                             nullptr,
+                                             kMSDomain);
+    embedding_bag_node.AddAttribute("mode", mean ? std::string("mean") : std::string("sum"));
+    embedding_bag_node.SetExecutionProviderType(provider);
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, embedding_bag_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class EmbeddingBagFusion
+
+Fuse a pooled embedding lookup into a single com.microsoft EmbeddingBag node:
+  Gather(axis=0) [--> Mul(per_sample_weights)] --> ReduceSum/ReduceMean(bag axis, keepdims=0)
+The fused kernel pools straight from the embedding table instead of materializing the gathered rows.
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Gather", "Mul", "ReduceMean", "ReduceSum"};
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
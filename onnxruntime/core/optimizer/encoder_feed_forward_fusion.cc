@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/encoder_feed_forward_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.Type();
+  return type != nullptr && *type == "tensor(float)";
+}
+
+bool IsConstantWithRank(const Graph& graph, const NodeArg& arg, int rank) {
+  const auto* shape = arg.Shape();
+  return graph_utils::NodeArgIsConstant(graph, arg) && shape != nullptr && shape->dim_size() == rank;
+}
+
+// Returns the producer of the given input when it is a MatMul by a constant 2D weight that feeds only 'consumer'.
+Node* GetMatMulWithConstantWeight(Graph& graph, const Node& consumer, const NodeArg& input,
+                                  const ProviderType& provider) {
+  const Node* producer = graph.GetProducerNode(input.Name());
+  if (producer == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "MatMul", {1, 9, 13}) ||
+      producer->GetExecutionProviderType() != provider ||
+      !optimizer_utils::CheckOutputEdges(graph, *producer, 1) ||
+      producer->OutputNodesBegin()->Index() != consumer.Index() ||
+      !IsConstantWithRank(graph, *producer->InputDefs()[1], 2)) {
+    return nullptr;
+  }
+  return graph.GetNode(producer->Index());
+}
+
+// SkipLayerNormalization may also produce mean, inv_std_var and input_skip_bias_sum. They must not be needed.
+bool OnlyFirstOutputUsed(const Graph& graph, const Node& node) {
+  const auto& outputs = node.OutputDefs();
+  for (size_t i = 1; i < outputs.size(); ++i) {
+    if (outputs[i]->Exists() &&
+        (graph.IsOutput(outputs[i]) || !graph.GetConsumerNodes(outputs[i]->Name()).empty())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status EncoderFeedForwardFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                           const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // node was removed
+
+    auto& skip_ln_node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(skip_ln_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(skip_ln_node, "SkipLayerNormalization", {1}, kMSDomain) ||
+        !graph_utils::IsSupportedProvider(skip_ln_node, GetCompatibleExecutionProviders()) ||
+        !IsFloatTensor(*skip_ln_node.InputDefs()[0]) ||
+        !OnlyFirstOutputUsed(graph, skip_ln_node)) {
+      continue;
+    }
+
+    const auto& provider = skip_ln_node.GetExecutionProviderType();
+    const auto& skip_ln_inputs = skip_ln_node.InputDefs();
+
+    // Either input of SkipLayerNormalization may be the output of the second projection.
+    Node* matmul2_node = nullptr;
+    NodeArg* residual = nullptr;
+    for (int i = 0; i < 2 && matmul2_node == nullptr; ++i) {
+      matmul2_node = GetMatMulWithConstantWeight(graph, skip_ln_node, *skip_ln_inputs[i], provider);
+      residual = skip_ln_node.MutableInputDefs()[1 - i];
+    }
+    const auto* residual_shape = residual->Shape();
+    if (matmul2_node == nullptr || residual_shape == nullptr ||
+        (residual_shape->dim_size() != 2 && residual_shape->dim_size() != 3)) {
+      continue;
+    }
+
+    Node* gelu_node = const_cast<Node*>(graph.GetProducerNode(matmul2_node->InputDefs()[0]->Name()));
+    if (gelu_node == nullptr ||
+        !(graph_utils::IsSupportedOptypeVersionAndDomain(*gelu_node, "BiasGelu", {1}, kMSDomain) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(*gelu_node, "FastGelu", {1}, kMSDomain)) ||
+        gelu_node->GetExecutionProviderType() != provider ||
+        !optimizer_utils::CheckOutputEdges(graph, *gelu_node, 1) ||
+        gelu_node->InputDefs().size() < 2 || !gelu_node->InputDefs()[1]->Exists() ||
+        !IsConstantWithRank(graph, *gelu_node->InputDefs()[1], 1)) {
+      continue;
+    }
+
+    Node* matmul1_node = GetMatMulWithConstantWeight(graph, *gelu_node, *gelu_node->InputDefs()[0], provider);
+    if (matmul1_node == nullptr || matmul1_node->InputDefs()[0] != residual) {
+      continue;
+    }
+
+    // gamma, beta and the bias of the second projection are weights of the fused node.
+    NodeArg* gamma = skip_ln_node.MutableInputDefs()[2];
+    NodeArg* beta = skip_ln_inputs.size() > 3 && skip_ln_inputs[3]->Exists() ? skip_ln_node.MutableInputDefs()[3]
+                                                                               : nullptr;
+    NodeArg* bias2 = skip_ln_inputs.size() > 4 && skip_ln_inputs[4]->Exists() ? skip_ln_node.MutableInputDefs()[4]
+                                                                                : nullptr;
+    if (!IsConstantWithRank(graph, *gamma, 1) ||
+        (beta != nullptr && !IsConstantWithRank(graph, *beta, 1)) ||
+        (bias2 != nullptr && !IsConstantWithRank(graph, *bias2, 1))) {
+      continue;
+    }
+
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+    InlinedVector<NodeArg*> fused_inputs{
+        residual,
+        matmul1_node->MutableInputDefs()[1],
+        gelu_node->MutableInputDefs()[1],
+        matmul2_node->MutableInputDefs()[1],
+        gamma,
+        beta != nullptr ? beta : &empty_arg,
+        bias2 != nullptr ? bias2 : &empty_arg};
+
+    Node& ffn_node = graph.AddNode(graph.GenerateNodeName("EncoderFeedForward"),
+                                   "EncoderFeedForward",
+                                   "fused MatMul, " + gelu_node->OpType() + ", MatMul and SkipLayerNormalization",
+                                   fused_inputs,
+                                   {},
+                                   nullptr,
+                                   kMSDomain);
+    ffn_node.AddAttribute("activation", gelu_node->OpType() == "FastGelu" ? std::string("FastGelu")
+                                                                         : std::string("Gelu"));
+    const auto* epsilon_attr = graph_utils::GetNodeAttribute(skip_ln_node, "epsilon");
+    if (epsilon_attr != nullptr) {
+      ffn_node.AddAttributeProto(*epsilon_attr);
+    }
+    ffn_node.SetExecutionProviderType(provider);
+
+    graph_utils::FinalizeNodeFusion(graph, {*matmul1_node, *gelu_node, *matmul2_node, skip_ln_node}, ffn_node);
+
+    // The optional outputs of SkipLayerNormalization were moved too. They are unused, so drop them.
+    ffn_node.MutableOutputDefs().resize(1);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
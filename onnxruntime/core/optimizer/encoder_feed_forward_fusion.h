@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class EncoderFeedForwardFusion
+
+Fuse the feed forward block of a transformer encoder layer into a single com.microsoft EncoderFeedForward node:
+  X --> MatMul(W1) --> BiasGelu/FastGelu(B1) --> MatMul(W2) --> SkipLayerNormalization(skip=X)
+The fused kernel runs the block tile by tile so the intermediate activation stays in cache.
+It should run after BiasGeluFusion, FastGeluFusion and SkipLayerNormFusion.
+*/
+class EncoderFeedForwardFusion : public GraphTransformer {
+ public:
+  EncoderFeedForwardFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EncoderFeedForwardFusion", compatible_execution_providers) {}
+
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"BiasGelu", "FastGelu", "MatMul", "SkipLayerNormalization"};
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -29,6 +29,10 @@ class FastGeluFusion : public GraphTransformer {
   FastGeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("FastGeluFusion", compatible_execution_providers) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Cast", "Mul", "Pow", "Tanh"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
  private:
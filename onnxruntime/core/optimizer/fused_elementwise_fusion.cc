@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/fused_elementwise_fusion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsTensorOfType(const NodeArg& arg, const char* type_str) {
+  const auto* type = arg.Type();
+  return type != nullptr && *type == type_str;
+}
+
+// The element-wise ops FusedElementwise implements, with float inputs except for the condition of Where.
+bool IsFusibleNode(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Where", {9, 16})) {
+    return false;
+  }
+
+  const auto& inputs = node.InputDefs();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const bool is_condition = i == 0 && node.OpType() == "Where";
+    if (!IsTensorOfType(*inputs[i], is_condition ? "tensor(bool)" : "tensor(float)")) {
+      return false;
+    }
+  }
+  return IsTensorOfType(*node.OutputDefs()[0], "tensor(float)");
+}
+
+// Same rank and the same dim value or dim param in each dimension.
+bool HasSameShape(const NodeArg& arg, const NodeArg& other) {
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (utils::HasDimValue(dim) && utils::HasDimValue(other_dim)) {
+      if (dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (!utils::HasDimParam(dim) || !utils::HasDimParam(other_dim) ||
+               dim.dim_param() != other_dim.dim_param()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status FusedElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  InlinedHashMap<NodeIndex, size_t> topological_position;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    topological_position[node_topology_list[i]] = i;
+  }
+
+  // Grow each chain backwards from its last node, so the nodes are visited in reverse topological order.
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    auto* node_ptr = graph.GetNode(*it);
+    if (node_ptr == nullptr)
+      continue;  // node was removed
+
+    auto& root = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(root, modified, graph_level, logger));
+
+    if (!IsFusibleNode(root) ||
+        !graph_utils::IsSupportedProvider(root, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const auto& provider = root.GetExecutionProviderType();
+    const NodeArg& root_output = *root.OutputDefs()[0];
+
+    InlinedVector<Node*> chain{&root};
+    InlinedHashSet<NodeIndex> chain_nodes{root.Index()};
+    for (size_t i = 0; i < chain.size(); ++i) {
+      for (auto edge = chain[i]->InputEdgesBegin(); edge != chain[i]->InputEdgesEnd(); ++edge) {
+        const Node& producer = edge->GetNode();
+        if (chain_nodes.count(producer.Index()) == 0 &&
+            producer.GetExecutionProviderType() == provider &&
+            IsFusibleNode(producer) &&
+            optimizer_utils::CheckOutputEdges(graph, producer, 1) &&
+            HasSameShape(*producer.OutputDefs()[0], root_output)) {
+          chain.push_back(graph.GetNode(producer.Index()));
+          chain_nodes.insert(producer.Index());
+        }
+      }
+    }
+
+    if (chain.size() < 2) {
+      continue;
+    }
+
+    std::sort(chain.begin(), chain.end(), [&topological_position](const Node* a, const Node* b) {
+      return topological_position[a->Index()] < topological_position[b->Index()];
+    });
+
+    // The inputs of the chain are the inputs of its nodes that are not produced inside of it.
+    auto is_chain_output = [&graph, &chain_nodes](const NodeArg& arg) {
+      const Node* producer = graph.GetProducerNode(arg.Name());
+      return producer != nullptr && chain_nodes.count(producer->Index()) != 0;
+    };
+
+    InlinedVector<NodeArg*> fused_inputs;
+    InlinedHashMap<const NodeArg*, int64_t> registers;
+    for (Node* node : chain) {
+      for (NodeArg* input : node->MutableInputDefs()) {
+        if (!is_chain_output(*input) && registers.count(input) == 0) {
+          registers[input] = static_cast<int64_t>(fused_inputs.size());
+          fused_inputs.push_back(input);
+        }
+      }
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    for (size_t step = 0; step < chain.size(); ++step) {
+      const Node& node = *chain[step];
+      ops.push_back(node.OpType());
+      const auto& inputs = node.InputDefs();
+      for (size_t j = 0; j < 3; ++j) {
+        operands.push_back(j < inputs.size() ? registers[inputs[j]] : -1);
+      }
+      registers[node.OutputDefs()[0]] = static_cast<int64_t>(fused_inputs.size() + step);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused element-wise chain",
+                                     fused_inputs,
+                                     {root.MutableOutputDefs()[0]},
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.SetExecutionProviderType(provider);
+
+    for (size_t i = 0; i < fused_inputs.size(); ++i) {
+      const Node* producer = graph.GetProducerNode(fused_inputs[i]->Name());
+      if (producer != nullptr) {
+        int src_arg_index = graph_utils::GetNodeOutputIndexFromOutputName(*producer, fused_inputs[i]->Name());
+        graph.AddEdge(producer->Index(), fused_node.Index(), src_arg_index, static_cast<int>(i));
+      }
+    }
+
+    auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(root);
+    for (const auto& edge : output_edges) {
+      graph.AddEdge(fused_node.Index(), edge.dst_node, 0, edge.dst_arg_index);
+    }
+    graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+
+    for (auto node = chain.rbegin(); node != chain.rend(); ++node) {
+      graph_utils::RemoveNodeOutputEdges(graph, **node);
+      graph.RemoveNode((*node)->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class FusedElementwiseFusion
+
+Collapse connected chains of float Add, Sub, Mul, Div, Sqrt, Erf, Tanh and Where nodes into a single
+com.microsoft FusedElementwise node, which evaluates the chain chunk by chunk in one pass over the data.
+Only nodes whose output is used by the next node of the chain alone, and has the same shape as the output of the
+chain, are fused. Broadcasting is therefore limited to the inputs of the chain and no work is repeated.
+It should run after the fusions that match specific element-wise patterns such as Gelu and LayerNormalization.
+*/
+class FusedElementwiseFusion : public GraphTransformer {
+ public:
+  FusedElementwiseFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("FusedElementwiseFusion", compatible_execution_providers) {}
+
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Sub", "Mul", "Div", "Sqrt", "Erf", "Tanh", "Where"};
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
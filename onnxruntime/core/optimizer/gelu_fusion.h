@@ -38,6 +38,10 @@ class GeluFusion : public GraphTransformer {
         optimization_level_(level),
         allow_contrib_op_in_level_1_(allow_contrib_op_in_level_1) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Div", "Erf", "Mul"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
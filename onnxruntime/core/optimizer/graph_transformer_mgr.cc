@@ -2,6 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+
+#include "core/common/hash_combine.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -19,6 +25,162 @@ common::Status GraphTransformerManager::GetSteps(unsigned& steps) const {
   return Status::OK();
 }
 
+namespace {
+
+// Number of leading elements of a list or bytes of tensor data that are hashed. Attributes such as the node lists of
+// a tree ensemble or the value of a large Constant can be megabytes, and every node is hashed again after each
+// transformer that modifies the graph, so only their size, a prefix and the last element are hashed. Transformers
+// replace such attributes rather than editing them in place, so this does not miss their changes in practice.
+constexpr int kMaxHashedAttributeElements = 64;
+
+template <typename Values>
+void HashAttributeValues(const Values& values, size_t& seed) {
+  const int size = values.size();
+  HashCombine(size, seed);
+  for (int i = 0, end = std::min(size, kMaxHashedAttributeElements); i < end; ++i) {
+    HashCombine(values[i], seed);
+  }
+
+  if (size > kMaxHashedAttributeElements) {
+    HashCombine(values[size - 1], seed);
+  }
+}
+
+void HashAttributeTensor(const ONNX_NAMESPACE::TensorProto& tensor, size_t& seed) {
+  HashCombine(tensor.data_type(), seed);
+  HashAttributeValues(tensor.dims(), seed);
+  const std::string_view raw_data = tensor.raw_data();
+  HashCombine(raw_data.size(), seed);
+  HashCombine(raw_data.substr(0, kMaxHashedAttributeElements), seed);
+  HashAttributeValues(tensor.float_data(), seed);
+  HashAttributeValues(tensor.int32_data(), seed);
+  HashAttributeValues(tensor.int64_data(), seed);
+  HashAttributeValues(tensor.double_data(), seed);
+  HashAttributeValues(tensor.uint64_data(), seed);
+  HashAttributeValues(tensor.string_data(), seed);
+}
+
+// Hash of the names and values of the attributes of a node, computed from the fields of each attribute without
+// serializing it. Attributes are stored in an unordered map, so the per-attribute hashes are summed to not depend on
+// the iteration order. Subgraphs are tracked as graphs of their own, so only the name of a graph attribute is
+// included.
+size_t AttributesSignature(const Node& node) {
+  size_t signature = 0;
+  for (const auto& [name, attr] : node.GetAttributes()) {
+    size_t seed = 0;
+    HashCombine(name, seed);
+    HashCombine(static_cast<int>(attr.type()), seed);
+    switch (attr.type()) {
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_FLOAT:
+        HashCombine(attr.f(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_INT:
+        HashCombine(attr.i(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_STRING:
+        HashCombine(attr.s(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_TENSOR:
+        HashAttributeTensor(attr.t(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS:
+        HashAttributeValues(attr.floats(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_INTS:
+        HashAttributeValues(attr.ints(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS:
+        HashAttributeValues(attr.strings(), seed);
+        break;
+      case ONNX_NAMESPACE::AttributeProto_AttributeType_TENSORS:
+        HashCombine(attr.tensors_size(), seed);
+        for (int i = 0, end = std::min(attr.tensors_size(), kMaxHashedAttributeElements); i < end; ++i) {
+          HashAttributeTensor(attr.tensors(i), seed);
+        }
+        break;
+      default:
+        // graphs are tracked separately. sparse tensors and type protos are rare in attributes, their count is
+        // enough to notice them being added or removed.
+        HashCombine(attr.sparse_tensors_size() + attr.type_protos_size(), seed);
+        break;
+    }
+
+    signature += seed;
+  }
+
+  return signature;
+}
+
+// Summarizes what a transformer can observe about a node: its type, attribute values, where it runs, how it is
+// connected and the shapes it produces. Rewiring, fusing or constant folding a neighbor changes the signature.
+size_t NodeSignature(const Node& node) {
+  size_t seed = 0;
+  HashCombine(node.OpType(), seed);
+  HashCombine(node.Domain(), seed);
+  HashCombine(node.GetExecutionProviderType(), seed);
+  HashCombine(AttributesSignature(node), seed);
+  HashCombine(node.GetInputEdgesCount(), seed);
+  HashCombine(node.GetOutputEdgesCount(), seed);
+  for (const auto* input : node.InputDefs()) {
+    HashCombine(input->Name(), seed);
+  }
+
+  for (const auto* output : node.OutputDefs()) {
+    HashCombine(output->Name(), seed);
+    const auto* shape = output->Shape();
+    if (shape != nullptr) {
+      for (const auto& dim : shape->dim()) {
+        HashCombine(dim.has_dim_value() ? dim.dim_value() : -1, seed);
+      }
+    }
+  }
+
+  return seed;
+}
+
+}  // namespace
+
+size_t GraphTransformerManager::GraphChangeTracker::Update(const Graph& graph,
+                                                           InlinedHashSet<std::string>& changed_op_types) {
+  size_t changed_nodes = 0;
+  auto& signatures = signatures_[&graph];
+  signatures.resize(graph.MaxNodeIndex(), 0);
+
+  for (int i = 0, end = graph.MaxNodeIndex(); i < end; ++i) {
+    const Node* node = graph.GetNode(i);
+    const size_t signature = node != nullptr ? NodeSignature(*node) : 0;
+    if (signature == signatures[i]) {
+      continue;
+    }
+
+    signatures[i] = signature;
+    ++changed_nodes;
+    if (node == nullptr) {
+      continue;  // the neighbors of a removed node were rewired, so they changed as well
+    }
+
+    changed_op_types.insert(node->OpType());
+    for (auto it = node->InputNodesBegin(), it_end = node->InputNodesEnd(); it != it_end; ++it) {
+      changed_op_types.insert(it->OpType());
+    }
+    for (auto it = node->OutputNodesBegin(), it_end = node->OutputNodesEnd(); it != it_end; ++it) {
+      changed_op_types.insert(it->OpType());
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    if (!node.ContainsSubgraph()) {
+      continue;
+    }
+
+    for (const auto& subgraph : node.GetSubgraphs()) {
+      changed_nodes += Update(*subgraph, changed_op_types);
+    }
+  }
+
+  return changed_nodes;
+}
+
 common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, TransformerLevel level,
                                                           const logging::Logger& logger) const {
   const auto& transformers = level_to_transformer_map_.find(level);
@@ -26,17 +188,65 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  struct TransformerState {
+    InlinedVector<std::string_view> target_op_types;
+    // op types around the nodes changed since the transformer last ran
+    InlinedHashSet<std::string> pending_op_types;
+    unsigned runs = 0;
+    unsigned skipped = 0;
+    unsigned modified_runs = 0;
+    size_t changed_nodes = 0;
+    std::chrono::steady_clock::duration duration{};
+  };
+
+  const auto& level_transformers = transformers->second;
+  InlinedVector<TransformerState> states(level_transformers.size());
+  for (size_t i = 0; i < level_transformers.size(); ++i) {
+    states[i].target_op_types = level_transformers[i]->TargetOpTypes();
+  }
+
+  GraphChangeTracker change_tracker;
+  InlinedHashSet<std::string> changed_op_types;
+  change_tracker.Update(graph, changed_op_types);
+
   for (unsigned step = 0; step < steps_; ++step) {
     if (IsLoadCancellationFlagSet()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED, "Graph transformation canceled due to user request.");
     }
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < level_transformers.size(); ++i) {
+      const auto& transformer = level_transformers[i];
+      auto& state = states[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      // A transformer that has already run can only find new matches where the graph changed since.
+      if (step > 0 && !state.target_op_types.empty() &&
+          std::none_of(state.target_op_types.begin(), state.target_op_types.end(),
+                       [&state](std::string_view op_type) {
+                         return state.pending_op_types.find(std::string(op_type)) != state.pending_op_types.end();
+                       })) {
+        ++state.skipped;
+        continue;
+      }
+
+      state.pending_op_types.clear();
+
       bool modified = false;
+      const auto start = std::chrono::steady_clock::now();
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      state.duration += std::chrono::steady_clock::now() - start;
+      ++state.runs;
+
+      if (modified) {
+        ++state.modified_runs;
+        changed_op_types.clear();
+        state.changed_nodes += change_tracker.Update(graph, changed_op_types);
+        for (auto& other_state : states) {
+          other_state.pending_op_types.insert(changed_op_types.begin(), changed_op_types.end());
+        }
+      }
+
       graph_changed = graph_changed || modified;
     }
     if (!graph_changed) {
@@ -44,6 +254,14 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     }
   }
 
+  for (size_t i = 0; i < level_transformers.size(); ++i) {
+    const auto& state = states[i];
+    LOGS(logger, VERBOSE) << "GraphTransformer " << level_transformers[i]->Name() << " ran " << state.runs
+                          << " times (skipped " << state.skipped << ", modified the graph " << state.modified_runs
+                          << " times, " << state.changed_nodes << " nodes changed) in "
+                          << std::chrono::duration_cast<std::chrono::microseconds>(state.duration).count() << "us";
+  }
+
   return Status::OK();
 }
 
@@ -43,6 +43,17 @@ class GraphTransformerManager {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
+  // Keeps a signature of every node in a graph and its subgraphs so the nodes a transformer changed can be found.
+  class GraphChangeTracker {
+   public:
+    // Refreshes the signatures, adding the op types of changed nodes and of their neighbors to changed_op_types.
+    // Returns the number of nodes that were added, removed or changed since the previous call.
+    size_t Update(const Graph& graph, InlinedHashSet<std::string>& changed_op_types);
+
+   private:
+    InlinedHashMap<const Graph*, std::vector<size_t>> signatures_;
+  };
+
   // maximum number of graph transformation steps
   unsigned steps_;
 
@@ -38,6 +38,10 @@ class LayerNormFusion : public GraphTransformer {
         optimization_level_(level),
         allow_contrib_op_in_level_1_(allow_contrib_op_in_level_1) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Cast", "Div", "Mul", "Pow", "ReduceMean", "Sqrt", "Sub"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -57,6 +61,10 @@ class SimplifiedLayerNormFusion : public GraphTransformer {
       : GraphTransformer("SimplifiedLayerNormFusion", compatible_execution_providers),
         skip_device_check_(skip_device_check) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Cast", "Div", "Mul", "Pow", "ReduceMean", "Sqrt", "Sub"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
  private:
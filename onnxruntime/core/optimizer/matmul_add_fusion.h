@@ -12,6 +12,10 @@ class MatMulAddFusion : public GraphTransformer {
   MatMulAddFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("MatMulAddFusion", compatible_execution_providers) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "LayerNormalization", "MatMul", "Reshape", "Shape"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -1222,14 +1222,290 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
   }
 }
 
+// Splits the graph into connected regions of nodes that have a NCHWc
+// implementation and estimates whether converting each region is worth the
+// reorders that are needed where tensors enter and leave the region. Costs are
+// in units of one float element that is read and written.
+class NchwcLayoutPlanner {
+ public:
+  NchwcLayoutPlanner(const Graph& graph, const logging::Logger& logger) noexcept
+      : graph_(graph), logger_(logger) {}
+
+  // Returns the nodes of the regions that should stay in NCHW layout.
+  InlinedHashSet<NodeIndex> SelectNchwNodes(const GraphViewer& graph_viewer);
+
+ private:
+  // The two constants below are relative weights, not measured timings. They
+  // only need to rank the savings of a region against its reorders, so the
+  // ratio between them is what matters.
+  //
+  // NCHWc convolutions avoid building the im2col buffer, which is counted
+  // separately in EstimateConvSavings, and use kernels that are tuned for the
+  // blocked layout. The blocked kernels are counted as 5% cheaper per
+  // multiply-add than the NCHW SGEMM path. With this weight a pointwise
+  // convolution with C input channels saves 0.05 * C units per output
+  // element. If it has as many input as output channels, reordering its own
+  // input and output costs 4 units per output element (see below), so on its
+  // own it is converted from 80 channels on. Convolutions with larger kernels
+  // also save the im2col buffer and pay off sooner.
+  static constexpr double kConvSavingsPerMac = 0.05;
+
+  // ReorderInput and ReorderOutput read and write each element once. One side
+  // is accessed with a stride of the channel block size, which costs about as
+  // much again as the contiguous pass, so a reordered element counts as 2
+  // units.
+  static constexpr double kReorderCostPerElement = 2.0;
+
+  struct Region {
+    InlinedVector<const Node*> nodes_;
+    InlinedHashSet<const NodeArg*> boundary_args_;
+    size_t conv_count_{0};
+    double conv_savings_{0.0};
+    double reorder_elements_{0.0};
+    bool has_unknown_shape_{false};
+  };
+
+  static bool IsConv(const Node& node);
+  static bool IsNchwcCapable(const Node& node);
+  static bool GetElementCount(const NodeArg& arg, double& count);
+
+  bool EstimateConvSavings(const Node& node, double& savings, bool& reorders_input) const;
+  void AddBoundaryArg(Region& region, const NodeArg& arg);
+  NodeIndex FindRegion(NodeIndex index);
+
+  const Graph& graph_;
+  const logging::Logger& logger_;
+
+  // Union-find parent of each NCHWc capable node.
+  InlinedHashMap<NodeIndex, NodeIndex> parents_;
+};
+
+bool NchwcLayoutPlanner::IsConv(const Node& node) {
+  return (node.OpType() == "Conv" && node.Domain() == kOnnxDomain) ||
+         (node.OpType() == "FusedConv" && node.Domain() == kMSDomain);
+}
+
+bool NchwcLayoutPlanner::IsNchwcCapable(const Node& node) {
+  // These are the operators handled by NchwcTransformerImpl::Transform.
+  static const InlinedHashSet<std::string_view> nchwc_op_types{
+      "MaxPool", "AveragePool", "GlobalMaxPool", "GlobalAveragePool", "Add", "Sum", "Mul", "Concat", "Relu",
+      "Sigmoid", "Tanh", "BatchNormalization", "Upsample", "Resize"};
+
+  if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+    return false;
+  }
+  return IsConv(node) || (node.Domain() == kOnnxDomain && nchwc_op_types.count(node.OpType()) != 0);
+}
+
+bool NchwcLayoutPlanner::GetElementCount(const NodeArg& arg, double& count) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+  count = 1.0;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    count *= static_cast<double>(dim.dim_value());
+  }
+  return true;
+}
+
+bool NchwcLayoutPlanner::EstimateConvSavings(const Node& node, double& savings, bool& reorders_input) const {
+  const auto& input_defs = node.InputDefs();
+  const ONNX_NAMESPACE::TensorProto* conv_W_tensor_proto = nullptr;
+  if (input_defs.size() < 2 ||
+      !graph_.GetInitializedTensor(input_defs[1]->Name(), conv_W_tensor_proto) ||
+      conv_W_tensor_proto->dims_size() != 4 ||
+      conv_W_tensor_proto->dims(0) <= 0) {
+    return false;
+  }
+
+  double output_elements;
+  if (!GetElementCount(*node.OutputDefs()[0], output_elements)) {
+    return false;
+  }
+
+  int64_t group_count = 1;
+  const auto* group_attr = graph_utils::GetNodeAttribute(node, "group");
+  if (group_attr != nullptr && utils::HasInt(*group_attr)) {
+    group_count = group_attr->i();
+  }
+
+  // NchwcTransformerImpl::TransformConv reads a NCHW input directly if it has
+  // fewer channels than the NCHWc block size.
+  reorders_input = group_count > 1 ||
+                   static_cast<size_t>(conv_W_tensor_proto->dims(1)) >= MlasNchwcGetBlockSize();
+
+  const double macs = output_elements * static_cast<double>(conv_W_tensor_proto->dims(1) *
+                                                            conv_W_tensor_proto->dims(2) *
+                                                            conv_W_tensor_proto->dims(3));
+  savings = macs * kConvSavingsPerMac;
+
+  // The NCHW implementation only skips im2col for a pointwise convolution
+  // without striding.
+  bool is_pointwise = conv_W_tensor_proto->dims(2) == 1 && conv_W_tensor_proto->dims(3) == 1;
+  const auto* strides_attr = graph_utils::GetNodeAttribute(node, "strides");
+  if (strides_attr != nullptr) {
+    for (auto stride : strides_attr->ints()) {
+      is_pointwise = is_pointwise && stride == 1;
+    }
+  }
+  if (!is_pointwise) {
+    savings += macs * static_cast<double>(group_count) / static_cast<double>(conv_W_tensor_proto->dims(0));
+  }
+
+  return true;
+}
+
+void NchwcLayoutPlanner::AddBoundaryArg(Region& region, const NodeArg& arg) {
+  if (!region.boundary_args_.insert(&arg).second) {
+    return;
+  }
+  double elements;
+  if (GetElementCount(arg, elements)) {
+    region.reorder_elements_ += elements;
+  } else {
+    region.has_unknown_shape_ = true;
+  }
+}
+
+NodeIndex NchwcLayoutPlanner::FindRegion(NodeIndex index) {
+  NodeIndex root = index;
+  while (parents_[root] != root) {
+    root = parents_[root];
+  }
+  while (parents_[index] != root) {
+    NodeIndex next = parents_[index];
+    parents_[index] = root;
+    index = next;
+  }
+  return root;
+}
+
+InlinedHashSet<NodeIndex> NchwcLayoutPlanner::SelectNchwNodes(const GraphViewer& graph_viewer) {
+  const auto& node_indices = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : node_indices) {
+    const auto* node = graph_.GetNode(index);
+    if (node != nullptr && IsNchwcCapable(*node)) {
+      parents_[index] = index;
+    }
+  }
+
+  for (auto index : node_indices) {
+    if (parents_.count(index) == 0) {
+      continue;
+    }
+    const auto& node = *graph_.GetNode(index);
+    for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+      if (parents_.count(it->Index()) != 0) {
+        NodeIndex producer_region = FindRegion(node.Index());
+        NodeIndex consumer_region = FindRegion(it->Index());
+        if (producer_region != consumer_region) {
+          parents_[consumer_region] = producer_region;
+        }
+      }
+    }
+  }
+
+  InlinedHashMap<NodeIndex, Region> regions;
+  InlinedVector<NodeIndex> region_order;
+  for (auto index : node_indices) {
+    if (parents_.count(index) == 0) {
+      continue;
+    }
+    NodeIndex region_index = FindRegion(index);
+    auto insert_result = regions.try_emplace(region_index);
+    if (insert_result.second) {
+      region_order.push_back(region_index);
+    }
+    Region& region = insert_result.first->second;
+    const Node& node = *graph_.GetNode(index);
+    region.nodes_.push_back(&node);
+
+    const auto& input_defs = node.InputDefs();
+    size_t input_count = input_defs.size();
+    if (IsConv(node)) {
+      double savings;
+      bool reorders_input = true;
+      if (EstimateConvSavings(node, savings, reorders_input)) {
+        region.conv_count_++;
+        region.conv_savings_ += savings;
+      } else {
+        region.has_unknown_shape_ = true;
+      }
+      // The other inputs are the filter and the bias, which are reordered
+      // statically.
+      input_count = reorders_input ? 1 : 0;
+    }
+
+    for (size_t i = 0; i < input_count; i++) {
+      const NodeArg& input_arg = *input_defs[i];
+      if (!input_arg.Exists() || graph_.IsInitializedTensor(input_arg.Name())) {
+        continue;
+      }
+      const Node* producer = graph_.GetProducerNode(input_arg.Name());
+      if (producer == nullptr || parents_.count(producer->Index()) == 0 ||
+          FindRegion(producer->Index()) != region_index) {
+        AddBoundaryArg(region, input_arg);
+      }
+    }
+
+    const NodeArg& output_arg = *node.OutputDefs()[0];
+    bool leaves_region = graph_.IsOutput(&output_arg);
+    for (const Node* consumer : graph_.GetConsumerNodes(output_arg.Name())) {
+      if (parents_.count(consumer->Index()) == 0 || FindRegion(consumer->Index()) != region_index) {
+        leaves_region = true;
+      }
+    }
+    if (leaves_region) {
+      AddBoundaryArg(region, output_arg);
+    }
+  }
+
+  InlinedHashSet<NodeIndex> nchw_nodes;
+  for (auto region_index : region_order) {
+    const Region& region = regions[region_index];
+    // Nodes other than Conv are only converted to NCHWc as part of a region
+    // with a Conv node, so a region without Conv nodes is left as is.
+    if (region.conv_count_ == 0) {
+      continue;
+    }
+
+    const double reorder_cost = region.reorder_elements_ * kReorderCostPerElement;
+    const bool use_nchwc = region.has_unknown_shape_ || region.conv_savings_ >= reorder_cost;
+    LOGS(logger_, VERBOSE) << "NchwcTransformer: region starting at node '" << region.nodes_.front()->Name()
+                           << "' with " << region.nodes_.size() << " nodes and " << region.conv_count_
+                           << " Conv nodes: estimated savings " << region.conv_savings_ << ", reorder cost "
+                           << reorder_cost << (region.has_unknown_shape_ ? " (unknown shapes)" : "")
+                           << " -> " << (use_nchwc ? "NCHWc" : "NCHW");
+
+    if (!use_nchwc) {
+      for (const Node* node : region.nodes_) {
+        nchw_nodes.insert(node->Index());
+      }
+    }
+  }
+
+  return nchw_nodes;
+}
+
 Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   NchwcTransformerImpl impl(graph);
   GraphViewer graph_viewer(graph);
 
+  InlinedHashSet<NodeIndex> nchw_nodes;
+  if (use_cost_model_) {
+    NchwcLayoutPlanner planner(graph, logger);
+    nchw_nodes = planner.SelectNchwNodes(graph_viewer);
+  }
+
   for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
     auto& node = *graph.GetNode(index);
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
-    if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+    if (node.GetExecutionProviderType() == kCpuExecutionProvider && nchw_nodes.count(index) == 0) {
       impl.Transform(node);
     }
   }
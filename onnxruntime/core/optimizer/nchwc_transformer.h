@@ -13,13 +13,21 @@ namespace onnxruntime {
 
 Transformer that optimizes the graph by using NCHWc nodes instead of NCHW nodes
 and inserts nodes to reorder tensors as needed.
+
+If use_cost_model is set, the graph is first split into connected regions of
+nodes that have a NCHWc implementation. A region is left in NCHW layout if the
+estimated savings of its Conv nodes do not cover the cost of reordering the
+tensors that enter and leave the region.
 */
 class NchwcTransformer : public GraphTransformer {
  public:
-  NchwcTransformer() noexcept : GraphTransformer("NchwcTransformer") {}
+  NchwcTransformer(bool use_cost_model = false) noexcept
+      : GraphTransformer("NchwcTransformer"), use_cost_model_(use_cost_model) {}
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool use_cost_model_;
 };
 
 }  // namespace onnxruntime
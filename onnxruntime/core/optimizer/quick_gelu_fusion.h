@@ -15,6 +15,10 @@ class QuickGeluFusion : public GraphTransformer {
   QuickGeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("QuickGeluFusion", compatible_execution_providers) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Mul", "Sigmoid"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -18,6 +18,10 @@ class SkipLayerNormFusion : public GraphTransformer {
   explicit SkipLayerNormFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("SkipLayerNormFusion", compatible_execution_providers) {}
 
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return {"Add", "Cast", "LayerNormalization"};
+  }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
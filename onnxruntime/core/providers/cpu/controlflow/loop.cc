@@ -23,6 +23,7 @@
 #include "core/framework/TensorSeq.h"
 #include "core/providers/utils.h"
 
+#include <algorithm>
 #include <gsl/gsl>
 
 #ifdef _MSC_VER
@@ -211,7 +212,7 @@ class LoopImpl {
 
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
-  void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  void SaveOutputsAndUpdateFeeds(std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
@@ -455,20 +456,21 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   }
 }
 
-void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
+void LoopImpl::SaveOutputsAndUpdateFeeds(std::vector<OrtValue>& last_outputs,
                                          std::vector<OrtValue>& next_inputs) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
+  // last_outputs is cleared by the caller, so its values are moved rather than copied.
 
-  // simple copy for cond and loop carried vars. start at 1 to skip iter_num in input
+  // simple move for cond and loop carried vars. start at 1 to skip iter_num in input
   for (ptrdiff_t i = 1; i < info_.num_subgraph_inputs; ++i) {
-    next_inputs[i] = last_outputs[i - 1];
+    next_inputs[i] = std::move(last_outputs[i - 1]);
   }
 
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
-    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(std::move(last_outputs[j + 1]));  // skip 'cond' in output
   }
 }
 
@@ -499,6 +501,17 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   std::vector<OrtValue> fetches;
 
   CreateInitialFeeds(feeds);
+  fetches.reserve(static_cast<size_t>(info_.num_outputs) + 1);
+
+  // avoid regrowing the per-iteration loop outputs when the trip count is known up front.
+  // loops bounded only by the condition grow them on demand.
+  if (max_trip_count_ > 0 && max_trip_count_ != INT64_MAX) {
+    constexpr int64_t kMaxReservedIterations = 4096;
+    const auto iterations_to_reserve = static_cast<size_t>(std::min(max_trip_count_, kMaxReservedIterations));
+    for (auto& per_iteration_outputs : loop_output_tensors_) {
+      per_iteration_outputs.reserve(iterations_to_reserve);
+    }
+  }
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
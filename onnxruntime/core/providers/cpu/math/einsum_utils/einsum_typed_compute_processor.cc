@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "einsum_typed_compute_processor.h"
+
+#include <algorithm>
+#include <numeric>
+
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 
@@ -332,6 +336,157 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   return output;
 }
 
+// Simulates the pair-wise contraction of the inputs in the given order and returns the estimated cost
+// (the sum of the number of multiply-adds of each MatMul).
+// `subscript_indices_to_last_position` holds, for each subscript index, the position in `input_order` after which the
+// subscript index is reduced (-1 if it appears in the output).
+static double EstimateContractionCost(const std::vector<TensorShape>& input_dims,
+                                      gsl::span<const int> input_order,
+                                      gsl::span<const int64_t> subscript_indices_to_last_position) {
+  const size_t num_subscript_indices = subscript_indices_to_last_position.size();
+  TensorShapeVector current_dims(num_subscript_indices, 1);
+  double cost = 0;
+
+  for (size_t position = 0; position < input_order.size(); ++position) {
+    const auto dims = input_dims[input_order[position]].GetDims();
+    double step_cost = 1;
+    for (size_t i = 0; i < num_subscript_indices; ++i) {
+      current_dims[i] = std::max(current_dims[i], dims[i]);
+      step_cost *= static_cast<double>(current_dims[i]);
+      if (subscript_indices_to_last_position[i] == static_cast<int64_t>(position)) {
+        current_dims[i] = 1;
+      }
+    }
+
+    // the first input is only reduced and not multiplied
+    if (position > 0) {
+      cost += step_cost;
+    }
+  }
+
+  return cost;
+}
+
+// Computes, for each subscript index, the position in `input_order` of the last input that has a non-trivial
+// dim value for it, so it can be reduced right after that input was processed.
+static void ComputeLastPositions(const std::vector<TensorShape>& input_dims,
+                                 gsl::span<const int> input_order,
+                                 const std::vector<int64_t>& subscript_indices_to_last_input,
+                                 std::vector<int64_t>& subscript_indices_to_last_position) {
+  const size_t num_subscript_indices = subscript_indices_to_last_input.size();
+  subscript_indices_to_last_position.assign(num_subscript_indices, -1);
+
+  for (size_t i = 0; i < num_subscript_indices; ++i) {
+    if (subscript_indices_to_last_input[i] == -1) {
+      continue;  // appears in the output
+    }
+
+    for (size_t position = 0; position < input_order.size(); ++position) {
+      if (input_order[position] == subscript_indices_to_last_input[i]) {
+        // the dim value is 1 in all inputs - reducing it after its last input in the original order is fine
+        if (subscript_indices_to_last_position[i] == -1) {
+          subscript_indices_to_last_position[i] = static_cast<int64_t>(position);
+        }
+      }
+      if (input_dims[input_order[position]].GetDims()[i] != 1) {
+        subscript_indices_to_last_position[i] = static_cast<int64_t>(position);
+      }
+    }
+  }
+}
+
+// With 3 or more inputs, contracting them from left to right can create much larger intermediate results than needed
+// (e.g. 'ij,jk,k->i' with large i and k contracts i and k before reducing k).
+// Greedily picks the order in which each step creates the smallest intermediate result and returns true if that
+// order is estimated to be cheaper than the left to right order.
+static bool OptimizeContractionOrder(const std::vector<TensorShape>& input_dims,
+                                     const std::vector<int64_t>& subscript_indices_to_last_input,
+                                     InlinedVector<int>& input_order,
+                                     std::vector<int64_t>& subscript_indices_to_last_position) {
+  const int num_inputs = static_cast<int>(input_dims.size());
+  const size_t num_subscript_indices = subscript_indices_to_last_input.size();
+
+  // Number of elements of the intermediate result after contracting `current_dims` with input `next`.
+  // Subscript indices that are neither in the output nor in any of the inputs still to be processed are reduced.
+  auto intermediate_size = [&](const TensorShapeVector& current_dims, int next, const InlinedVector<bool>& processed) {
+    double size = 1;
+    const auto next_dims = input_dims[next].GetDims();
+    for (size_t i = 0; i < num_subscript_indices; ++i) {
+      const int64_t dim = std::max(current_dims[i], next_dims[i]);
+      bool keep = subscript_indices_to_last_input[i] == -1;
+      for (int input = 0; !keep && input < num_inputs; ++input) {
+        keep = !processed[input] && input != next && input_dims[input].GetDims()[i] != 1;
+      }
+      if (keep) {
+        size *= static_cast<double>(dim);
+      }
+    }
+    return size;
+  };
+
+  InlinedVector<bool> processed(num_inputs, false);
+  InlinedVector<int> greedy_order;
+  greedy_order.reserve(num_inputs);
+  TensorShapeVector current_dims(num_subscript_indices, 1);
+
+  while (static_cast<int>(greedy_order.size()) < num_inputs) {
+    int best_input = -1;
+    double best_size = 0;
+    for (int input = 0; input < num_inputs; ++input) {
+      if (processed[input]) {
+        continue;
+      }
+
+      // pick the first input as the one that creates the smallest intermediate result with any other input
+      double size = 0;
+      if (greedy_order.empty()) {
+        processed[input] = true;
+        const auto dims = input_dims[input].GetDims();
+        TensorShapeVector first_dims(dims.begin(), dims.end());
+        for (int other = 0; other < num_inputs; ++other) {
+          if (!processed[other]) {
+            const double pair_size = intermediate_size(first_dims, other, processed);
+            size = size == 0 ? pair_size : std::min(size, pair_size);
+          }
+        }
+        processed[input] = false;
+      } else {
+        size = intermediate_size(current_dims, input, processed);
+      }
+
+      if (best_input == -1 || size < best_size) {
+        best_input = input;
+        best_size = size;
+      }
+    }
+
+    const auto dims = input_dims[best_input].GetDims();
+    for (size_t i = 0; i < num_subscript_indices; ++i) {
+      current_dims[i] = std::max(current_dims[i], dims[i]);
+    }
+    processed[best_input] = true;
+    greedy_order.push_back(best_input);
+  }
+
+  InlinedVector<int> default_order(num_inputs);
+  std::iota(default_order.begin(), default_order.end(), 0);
+  if (greedy_order == default_order) {
+    return false;
+  }
+
+  std::vector<int64_t> greedy_last_position;
+  ComputeLastPositions(input_dims, greedy_order, subscript_indices_to_last_input, greedy_last_position);
+
+  if (EstimateContractionCost(input_dims, greedy_order, greedy_last_position) >=
+      EstimateContractionCost(input_dims, default_order, subscript_indices_to_last_input)) {
+    return false;
+  }
+
+  input_order = std::move(greedy_order);
+  subscript_indices_to_last_position = std::move(greedy_last_position);
+  return true;
+}
+
 template <typename T>
 void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Transpose& device_transpose_func,
                                                       const EinsumOp::DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -357,6 +512,19 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // Choose the order in which the inputs are processed. By default it is left to right and each subscript index is
+  // reduced after the last input it appears in.
+  InlinedVector<int> input_order(num_inputs);
+  std::iota(input_order.begin(), input_order.end(), 0);
+  std::vector<int64_t> reordered_last_position;
+  const bool reordered = num_inputs > 2 &&
+                         OptimizeContractionOrder(homogenized_input_dims, mapped_indices_to_last_input_index,
+                                                  input_order, reordered_last_position);
+  const std::vector<int64_t>& mapped_indices_to_last_position =
+      reordered ? reordered_last_position : mapped_indices_to_last_input_index;
+
+  const int first_input = input_order[0];
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
@@ -367,7 +535,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     preserved_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
     for (size_t i = 0; i < onnxruntime::narrow<size_t>(num_subscript_labels); ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
+      if (mapped_indices_to_last_position[i] == 0) {
         reduced_dims.push_back(i);
       } else {
         preserved_dims.push_back(i);
@@ -376,14 +544,15 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
     // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
+      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[first_input] ? *preprocessed_inputs[first_input]
+                                                                       : *raw_inputs[first_input],
+                                      homogenized_input_dims[first_input].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
     } else {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+      if (preprocessed_inputs[first_input]) {
+        result = std::move(preprocessed_inputs[first_input]);
       }
     }
 
@@ -401,21 +570,22 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   {
     bool is_final_pair = false;
     // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    for (int position = 1; position < num_inputs; ++position) {
+      const int input = input_order[position];
       TensorShapeVector reduced_dims;
       reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
+        if (mapped_indices_to_last_position[onnxruntime::narrow<size_t>(dim)] == position) {
           // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
+      if (position == num_inputs - 1) {
         is_final_pair = true;
       }
       // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
+      result = PairwiseOperandProcess(result ? *result : *raw_inputs[first_input],
+                                      result ? result->Shape() : homogenized_input_dims[first_input],
                                       preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
                                       homogenized_input_dims[input],
                                       reduced_dims, is_final_pair);
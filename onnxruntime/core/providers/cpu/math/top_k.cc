@@ -140,6 +140,67 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Selects the top k elements of the contiguous range [begin, end) of input_data using a heap of size k.
+// The heap is written to 'heap' in no particular order. end - begin must be at least k.
+template <class Comparator>
+static void HeapSelectTopKInRange(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                                  int64_t begin, int64_t end, const unsigned k, int64_t* heap) {
+  int64_t cur_idx = begin;
+
+  // add first k items starting from the bottom up
+  for (unsigned l = 0; l < k; ++l, ++cur_idx) {
+    heap[k - l - 1] = cur_idx;
+    HeapifyIthPosition(heap, k - l - 1, k, comparer);
+  }
+
+  // insert remainder if the next value would replace the top of the heap (current worst top k value)
+  auto top = input_data[heap[0]];
+  for (; cur_idx < end; ++cur_idx) {
+    if (comparer.CompareValueOnly(input_data[cur_idx], top)) {
+      heap[0] = cur_idx;
+      HeapifyIthPosition(heap, 0, k, comparer);
+      top = input_data[heap[0]];
+    }
+  }
+}
+
+// Handles inputs with a few very long rows along a contiguous axis (e.g. selecting the top 100 out of 1M candidates),
+// where splitting the work by rows leaves most of the thread pool idle. Each row is split into num_chunks ranges,
+// the top k of every range are selected in parallel and the final top k are selected from the num_chunks * k
+// candidates. As the comparer is a strict ordering on (value, index) the result is the same as for a single pass.
+template <class Comparator>
+static void FindTopKElementsSplitRows(const typename Comparator::DataType* input_data,
+                                      typename Comparator::DataType* values_data, int64_t* indices_data,
+                                      int64_t rows, int64_t num_blocks, const unsigned k, bool sorted,
+                                      int64_t num_chunks, concurrency::ThreadPool* threadpool) {
+  Comparator comparer(input_data);
+  std::vector<int64_t> candidates(SafeInt<size_t>(num_chunks) * k);
+  const int64_t chunk_size = num_blocks / num_chunks;
+
+  for (int64_t i = 0; i < rows; ++i) {
+    const int64_t row_offset = i * num_blocks;
+
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        threadpool, onnxruntime::narrow<std::ptrdiff_t>(num_chunks),
+        [&](std::ptrdiff_t chunk) {
+          const int64_t begin = row_offset + chunk * chunk_size;
+          const int64_t end = chunk == num_chunks - 1 ? row_offset + num_blocks : begin + chunk_size;
+          HeapSelectTopKInRange(comparer, input_data, begin, end, k, candidates.data() + chunk * k);
+        });
+
+    std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), comparer);
+    if (sorted) {
+      std::sort(candidates.begin(), candidates.begin() + k, comparer);
+    }
+
+    for (unsigned l = 0; l < k; ++l) {
+      const int64_t idx = candidates[l];
+      values_data[i * k + l] = input_data[idx];
+      indices_data[i * k + l] = idx - row_offset;
+    }
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -173,6 +234,19 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   int64_t threads_needed = static_cast<int64_t>(std::floor(input_shape.Size() * k / (128 * 1024)));
   num_threads = std::max(std::min(threads_needed, num_threads), static_cast<int64_t>(1));
 
+  // If there are fewer rows than threads, split long contiguous rows into chunks so all threads have work.
+  // Each chunk needs enough elements to amortize the final merge of the per-chunk top k candidates.
+  if (block_slice == 1 && k > 1 && rows < tp_threads) {
+    constexpr int64_t kMinElementsPerChunk = 16 * 1024;
+    const int64_t min_chunk_size = std::max<int64_t>(kMinElementsPerChunk, static_cast<int64_t>(k) * 8);
+    const int64_t num_chunks = std::min<int64_t>(tp_threads, num_blocks / min_chunk_size);
+    if (num_chunks > 1) {
+      FindTopKElementsSplitRows<Comparator>(input_data, values_data, indices_data, rows, num_blocks, k, sorted,
+                                            num_chunks, threadpool);
+      return;
+    }
+  }
+
   // from testing various batch sizes relative to k, the following appears to work well as a selector.
   // tested with following combinations
   //   batch_size = [ 8, 16, 32, 64, 128, 256, 512, 1024, 2048 ]
@@ -63,6 +63,9 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    if (get_kernel_type() == KERNEL::RBF) {
+      support_vector_squared_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+    }
   } else {
     feature_count_ = coefficients_.size() / class_count_;  // liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -245,59 +248,68 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
-                              threadpool);
+                              threadpool, support_vector_squared_norms_);
+
+    // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+    // per class.
+    // coefficients: [num_classes - 1, vector_count_]
+    //
+    // e.g. say you have 3 classes, with 3 x 3 coefficients
+    //
+    // AA AB AC
+    // BA BB BC
+    // CA CB CC
+    //
+    // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+    //
+    // BA AB AC
+    // CA CB BC
+    //
+    // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+    //
+    // Combine the scores for the two combinations for two classes with their coefficient.
+    // e.g. AB combines with BA.
+    // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+    //
+    // Rather than a dot product per batch and class pair, compute the partial sums for every coefficient row
+    // with one matrix product per class:
+    //   class_sums[n, c, r] = sum over support vectors s of class c of coefficients_[r, s] * kernels[n, s]
+    // The score for classes i < j is then class_sums[n, i, j - 1] + class_sums[n, j, i] + rho.
+    // The sums are accumulated in double as the votes depend on their sign.
+    using StridedRowMajorMap = Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+                                          0, Eigen::OuterStride<>>;
+    using StridedRowMajorDoubleMap = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+                                                0, Eigen::OuterStride<>>;
+    const int64_t coeff_rows = class_count_ - 1;
+    const int64_t class_sums_per_batch = class_count_ * coeff_rows;
+    std::vector<double> class_sums_data(num_batches * SafeInt<size_t>(class_sums_per_batch), 0.);
+
+    for (int64_t c = 0; c < class_count_ && coeff_rows > 0; c++) {
+      const int64_t start_index = starting_vector_[onnxruntime::narrow<size_t>(c)];
+      const int64_t class_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(c)];
+      if (class_support_count == 0) {
+        continue;
+      }
+
+      StridedRowMajorMap class_kernels(kernels_data.data() + start_index, num_batches, class_support_count,
+                                       Eigen::OuterStride<>(vector_count_));
+      StridedRowMajorMap class_coefficients(coefficients_.data() + start_index, coeff_rows, class_support_count,
+                                            Eigen::OuterStride<>(vector_count_));
+      StridedRowMajorDoubleMap class_sums(class_sums_data.data() + c * coeff_rows, num_batches, coeff_rows,
+                                          Eigen::OuterStride<>(class_sums_per_batch));
+      class_sums.noalias() = class_kernels.cast<double>() * class_coefficients.cast<double>().transpose();
+    }
 
     for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
+      const double* class_sums = class_sums_data.data() + n * class_sums_per_batch;
       auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
       auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
       auto scores_iter = cur_scores.begin();
 
       size_t classifier_idx = 0;
       for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
-        int64_t i_coeff_row_offset = vector_count_ * i;
-
         for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
-          const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
-          val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
+          double sum = class_sums[i * coeff_rows + j - 1] + class_sums[j * coeff_rows + i];
           sum += rho_[classifier_idx++];
 
           *scores_iter++ = static_cast<float>(sum);
@@ -30,37 +30,66 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // Squared L2 norm of each of the 'n' rows of 'vectors'. Used to turn the RBF distance into a GEMM.
+  static std::vector<float> squared_norms(gsl::span<const float> vectors, ptrdiff_t n, ptrdiff_t k) {
+    std::vector<float> norms(onnxruntime::narrow<size_t>(n), 0.f);
+    if (n > 0 && k > 0) {
+      EigenVectorMap<float>(norms.data(), n) = ConstEigenMatrixMapRowMajor<float>(vectors.data(), n, k)
+                                                   .rowwise()
+                                                   .squaredNorm();
+    }
+    return norms;
+  }
+
+  // b_squared_norms are the squared norms of the rows of 'b'. They are only used by RBF, which computes them
+  // from 'b' if they are not provided.
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
                           float scalar_C,
                           const gsl::span<T> out,
-                          concurrency::ThreadPool* threadpool) const {
+                          concurrency::ThreadPool* threadpool,
+                          gsl::span<const T> b_squared_norms = {}) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
-
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
+      // |x - s|^2 = |x|^2 + |s|^2 - 2 x.s so the cross term for the whole batch is a single GEMM.
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+      std::vector<T> computed_b_norms;
+      if (b_squared_norms.size() != size_t(n)) {
+        computed_b_norms = squared_norms(b, n, k);
+        b_squared_norms = computed_b_norms;
+      }
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
+      auto distances = EigenMatrixMapRowMajor<T>(out.data(), m, n);
+      const std::vector<T> a_squared_norms = squared_norms(a, m, k);
+      distances.colwise() += ConstEigenVectorMap<T>(a_squared_norms.data(), m);
+      distances.rowwise() += ConstEigenVectorMap<T>(b_squared_norms.data(), n).transpose();
+
+      // The expansion cancels when the distance is small compared to the norms, e.g. for features with a large
+      // common offset, and the result can be off by more than the distance itself. Those distances are computed
+      // from the difference of the vectors instead.
+      constexpr T kMinDistanceToNormsRatio = T(1) / T(16);
+      for (ptrdiff_t row = 0; row < m; ++row) {
+        for (ptrdiff_t col = 0; col < n; ++col) {
+          if (distances(row, col) < kMinDistanceToNormsRatio * (a_squared_norms[row] + b_squared_norms[col])) {
+            distances(row, col) = (ConstEigenVectorMap<T>(a.data() + row * k, k) -
+                                   ConstEigenVectorMap<T>(b.data() + col * k, k))
+                                      .squaredNorm();
           }
-
-          *cur_out++ = std::exp(-gamma_ * sum);
         }
-
-        cur_batch += k;  // move to start of next batch
       }
+
+      // rounding in the expansion can make the distance of nearly identical vectors slightly negative
+      auto map_out = EigenVectorArrayMap<T>(out.data(), out.size());
+      map_out = map_out.max(T(0)) * -gamma_;
+      MlasComputeExp(out.data(), out.data(), out.size());
     } else {
       float alpha = 1.f;
       float beta = 1.f;
@@ -106,6 +135,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::get_kernel_type;
   using SVMCommon::set_kernel_type;
+  using SVMCommon::squared_norms;
 
  public:
   SVMClassifier(const OpKernelInfo& info);
@@ -126,6 +156,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vector_squared_norms_;  // only populated for RBF
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
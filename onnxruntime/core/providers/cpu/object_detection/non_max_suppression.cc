@@ -17,6 +17,7 @@ limitations under the License.
 #include <utility>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -148,55 +149,82 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+  const int64_t num_boxes = pc.num_boxes_;
+  const int64_t num_classes = pc.num_classes_;
+  const bool has_score_threshold = pc.score_threshold_ != nullptr;
+
+  // Each (batch, class) pair is independent, so the pairs are processed in parallel and the selected box indices of
+  // each pair are concatenated afterwards in (batch, class) order. This keeps the output identical to processing the
+  // pairs sequentially.
+  const std::ptrdiff_t num_pairs = narrow<std::ptrdiff_t>(pc.num_batches_ * num_classes);
+  std::vector<std::vector<int64_t>> selected_boxes_per_pair(static_cast<size_t>(num_pairs));
+
+  auto select_boxes = [&](std::ptrdiff_t pair_index) {
+    const int64_t batch_index = pair_index / num_classes;
+    const float* batch_boxes = boxes_data + (batch_index * num_boxes * 4);
+    std::vector<BoxInfoPtr> candidate_boxes;
+    candidate_boxes.reserve(num_boxes);
+
+    // Filter by score_threshold_
+    const auto* class_scores = scores_data + pair_index * num_boxes;
+    if (has_score_threshold) {
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+        if (*class_scores > score_threshold) {
           candidate_boxes.emplace_back(*class_scores, box_index);
         }
       }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
+    } else {
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+        candidate_boxes.emplace_back(*class_scores, box_index);
+      }
+    }
+    std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
+
+    std::vector<int64_t>& selected_boxes_inside_class = selected_boxes_per_pair[pair_index];
+    selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class),
+                                                         sorted_boxes.size()));
+    // Get the next box with top score, filter by iou_threshold
+    while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
+      const BoxInfoPtr& next_top_score = sorted_boxes.top();
+
+      bool selected = true;
+      // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+      for (const auto selected_index : selected_boxes_inside_class) {
+        if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index, center_point_box, iou_threshold)) {
+          selected = false;
+          break;
         }
+      }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+      if (selected) {
+        selected_boxes_inside_class.push_back(next_top_score.index_);
+      }
+      sorted_boxes.pop();
+    }  // while
+  };
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_pairs, static_cast<double>(num_boxes) * 16.0,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t pair_index = first; pair_index < last; ++pair_index) {
+          select_boxes(pair_index);
         }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+      });
+
+  size_t total_selected = 0;
+  for (const auto& selected_boxes : selected_boxes_per_pair) {
+    total_selected += selected_boxes.size();
+  }
+
+  std::vector<SelectedIndex> selected_indices;
+  selected_indices.reserve(total_selected);
+  for (std::ptrdiff_t pair_index = 0; pair_index < num_pairs; ++pair_index) {
+    const int64_t batch_index = pair_index / num_classes;
+    const int64_t class_index = pair_index % num_classes;
+    for (const auto box_index : selected_boxes_per_pair[pair_index]) {
+      selected_indices.emplace_back(batch_index, class_index, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
@@ -8,6 +8,7 @@
 #include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -54,6 +55,9 @@ class DeepCpuGruOp final : public OpKernel {
     layout_ = info.GetAttrOrDefault("layout", static_cast<int64_t>(0));
     ORT_ENFORCE(layout_ == 0,
                 "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
+
+    concurrent_directions_ =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsRnnConcurrentBidirectional, "0") == "1";
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -80,6 +84,7 @@ class DeepCpuGruOp final : public OpKernel {
   float clip_;
   int linear_before_reset_{};
   int64_t layout_;
+  bool concurrent_directions_ = false;
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
@@ -6,6 +6,7 @@
 #include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -51,6 +52,9 @@ class LSTMBase {
 
     ORT_ENFORCE(layout_ == 0,
                 "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
+
+    concurrent_directions_ =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsRnnConcurrentBidirectional, "0") == "1";
   }
 
   ~LSTMBase() = default;
@@ -76,6 +80,7 @@ class LSTMBase {
   float clip_;
   bool input_forget_ = false;
   int64_t layout_;
+  bool concurrent_directions_ = false;
 
   rnn::detail::ActivationFuncs activation_funcs_;
 };
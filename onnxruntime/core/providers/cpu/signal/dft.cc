@@ -189,6 +189,146 @@ static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, s
   return Status::OK();
 }
 
+// Factorizes n into the radices handled by fft_mixed_radix. Radix 4 is preferred over radix 2 as it needs fewer
+// passes over the data. Returns false if n has a prime factor other than 2, 3 or 5, in which case the caller falls
+// back to the Bluestein algorithm.
+static bool factorize_mixed_radix(size_t n, InlinedVector<size_t>& factors) {
+  factors.clear();
+  for (size_t radix : {4, 2, 3, 5}) {
+    while (n % radix == 0) {
+      factors.push_back(radix);
+      n /= radix;
+    }
+  }
+  return n == 1;
+}
+
+template <typename T>
+static void fft_mixed_radix_butterfly(std::complex<T>* out, size_t fstride, const std::complex<T>* twiddles,
+                                      size_t dft_length, size_t m, size_t p) {
+  switch (p) {
+    case 2: {
+      for (size_t k = 0; k < m; k++) {
+        const std::complex<T> t = out[k + m] * twiddles[k * fstride];
+        out[k + m] = out[k] - t;
+        out[k] += t;
+      }
+      break;
+    }
+    case 4: {
+      // twiddles[dft_length / 4] is -i for the forward transform and +i for the inverse transform.
+      const std::complex<T> w4 = twiddles[dft_length / 4];
+      for (size_t k = 0; k < m; k++) {
+        const std::complex<T> s0 = out[k];
+        const std::complex<T> s1 = out[k + m] * twiddles[k * fstride];
+        const std::complex<T> s2 = out[k + 2 * m] * twiddles[2 * k * fstride];
+        const std::complex<T> s3 = out[k + 3 * m] * twiddles[3 * k * fstride];
+        const std::complex<T> a0 = s0 + s2;
+        const std::complex<T> a1 = s0 - s2;
+        const std::complex<T> a2 = s1 + s3;
+        const std::complex<T> a3 = (s1 - s3) * w4;
+        out[k] = a0 + a2;
+        out[k + m] = a1 + a3;
+        out[k + 2 * m] = a0 - a2;
+        out[k + 3 * m] = a1 - a3;
+      }
+      break;
+    }
+    default: {
+      // Generic butterfly used for radix 3 and 5.
+      std::complex<T> scratch[5];
+      for (size_t u = 0; u < m; u++) {
+        for (size_t q = 0; q < p; q++) {
+          scratch[q] = out[u + q * m];
+        }
+        for (size_t q1 = 0; q1 < p; q1++) {
+          const size_t k = u + q1 * m;
+          std::complex<T> acc = scratch[0];
+          size_t twiddle_index = 0;
+          for (size_t q = 1; q < p; q++) {
+            twiddle_index += fstride * k;
+            if (twiddle_index >= dft_length) {
+              twiddle_index -= dft_length;
+            }
+            acc += scratch[q] * twiddles[twiddle_index];
+          }
+          out[k] = acc;
+        }
+      }
+      break;
+    }
+  }
+}
+
+// Recursive decimation in time: splits the sequence read from `in` with stride `fstride` into p interleaved
+// subsequences of length m, transforms each of them and recombines them with a radix-p butterfly.
+template <typename T>
+static void fft_mixed_radix_work(std::complex<T>* out, const std::complex<T>* in, size_t fstride,
+                                 const size_t* factors, size_t length, const std::complex<T>* twiddles,
+                                 size_t dft_length) {
+  const size_t p = factors[0];
+  const size_t m = length / p;
+  if (m == 1) {
+    for (size_t q = 0; q < p; q++) {
+      out[q] = in[q * fstride];
+    }
+  } else {
+    for (size_t q = 0; q < p; q++) {
+      fft_mixed_radix_work(out + q * m, in + q * fstride, fstride * p, factors + 1, m, twiddles, dft_length);
+    }
+  }
+  fft_mixed_radix_butterfly(out, fstride, twiddles, dft_length, m, p);
+}
+
+template <typename T, typename U>
+static Status fft_mixed_radix(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, size_t X_offset, size_t X_stride,
+                              size_t Y_offset, size_t Y_stride, int64_t axis, size_t dft_length, const Tensor* window,
+                              bool is_onesided, bool inverse, const InlinedVector<size_t>& factors,
+                              InlinedVector<std::complex<T>>& V, InlinedVector<std::complex<T>>& temp_output) {
+  const auto& X_shape = X->Shape();
+  size_t number_of_samples = static_cast<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
+
+  auto* X_data = const_cast<U*>(reinterpret_cast<const U*>(X->DataRaw())) + X_offset;
+  U* window_data = nullptr;
+  if (window) {
+    window_data = const_cast<U*>(reinterpret_cast<const U*>(window->DataRaw()));
+  }
+
+  // The twiddle factors only depend on the dft length, so they are computed once and reused for every dft of the
+  // batch (and every frame of a STFT).
+  if (V.size() != dft_length) {
+    auto angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
+    V.resize(dft_length);
+    for (size_t i = 0; i < dft_length; i++) {
+      V[i] = compute_exponential(i, angular_velocity);
+    }
+  }
+
+  // The first half of temp_output holds the windowed and zero padded input, the second half the transformed signal.
+  if (temp_output.size() != 2 * dft_length) {
+    temp_output.resize(2 * dft_length);
+  }
+  std::complex<T>* input = temp_output.data();
+  std::complex<T>* output = temp_output.data() + dft_length;
+
+  for (size_t i = 0; i < dft_length; i++) {
+    auto x = (i < number_of_samples) ? *(X_data + i * X_stride) : 0;
+    auto window_element = window_data ? *(window_data + i) : 1;
+    input[i] = std::complex<T>(1, 0) * x * window_element;
+  }
+
+  fft_mixed_radix_work(output, input, 1, factors.data(), dft_length, V.data(), dft_length);
+
+  const size_t output_size = is_onesided ? (dft_length >> 1) + 1 : dft_length;
+  const T scale = inverse ? static_cast<T>(1) / static_cast<T>(dft_length) : static_cast<T>(1);
+  auto* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset;
+  for (size_t i = 0; i < output_size; i++) {
+    *(Y_data + i * Y_stride) = output[i] * scale;
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 T next_power_of_2(T in) {
   in--;
@@ -332,6 +472,13 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
+  // Lengths that are not a power of 2 but only have 2, 3 and 5 as prime factors (e.g. n_fft=400) use the
+  // mixed radix fft instead of the much more expensive Bluestein algorithm.
+  const size_t dft_length_size = onnxruntime::narrow<size_t>(dft_length);
+  const bool use_radix2 = is_power_of_2(dft_length_size);
+  InlinedVector<size_t> mixed_radix_factors;
+  const bool use_mixed_radix = !use_radix2 && factorize_mixed_radix(dft_length_size, mixed_radix_factors);
+
   // Calculate x/y offsets/strides
   for (size_t i = 0; i < total_dfts; i++) {
     size_t X_offset = 0;
@@ -362,9 +509,12 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
     }
 
-    if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
+    if (use_radix2) {
       ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
                                             is_onesided, inverse, V, temp_output)));
+    } else if (use_mixed_radix) {
+      ORT_RETURN_IF_ERROR((fft_mixed_radix<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, dft_length_size,
+                                                 window, is_onesided, inverse, mixed_radix_factors, V, temp_output)));
     } else {
       ORT_RETURN_IF_ERROR(
           (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
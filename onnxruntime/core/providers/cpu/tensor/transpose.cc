@@ -3,7 +3,10 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/framework/transpose_helper.h"
@@ -348,6 +351,75 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
   return true;
 }
 
+// Removes axes of size 1 and merges axes that stay adjacent and in the same order in the output into a single axis.
+// e.g. perm (0, 3, 4, 1, 2) over input dims (N, C, D, H, W) is equivalent to perm (0, 2, 1) over (N, C*D, H*W),
+// which can use the single axis transpose instead of the element wise fallback, and fewer axes make the
+// MultiIndex based fallback cheaper.
+// Returns false if no axis can be removed or merged.
+static bool SimplifyTranspose(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> input_dims,
+                              InlinedVector<size_t>& simplified_permutations,
+                              TensorShapeVector& simplified_input_dims,
+                              TensorShapeVector& simplified_output_dims) {
+  constexpr size_t kRemoved = std::numeric_limits<size_t>::max();
+  const size_t rank = input_dims.size();
+
+  // index of each input axis once the axes of size 1 are removed
+  InlinedVector<size_t> kept_axis(rank, kRemoved);
+  size_t num_kept = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) {
+      kept_axis[i] = num_kept++;
+    }
+  }
+
+  // walk the output axes and group runs of consecutive input axes
+  InlinedVector<size_t> group_first_axis;
+  TensorShapeVector group_dims;
+  size_t prev_axis = kRemoved;
+  for (size_t i = 0; i < rank; ++i) {
+    const size_t axis = kept_axis[permutations[i]];
+    if (axis == kRemoved) {
+      continue;
+    }
+
+    if (prev_axis != kRemoved && axis == prev_axis + 1) {
+      group_dims.back() *= input_dims[permutations[i]];
+    } else {
+      group_first_axis.push_back(axis);
+      group_dims.push_back(input_dims[permutations[i]]);
+    }
+    prev_axis = axis;
+  }
+
+  const size_t num_groups = group_first_axis.size();
+  if (num_groups == rank) {
+    return false;
+  }
+
+  // groups in input order
+  InlinedVector<size_t> input_order(num_groups);
+  std::iota(input_order.begin(), input_order.end(), size_t{0});
+  std::sort(input_order.begin(), input_order.end(), [&group_first_axis](size_t lhs, size_t rhs) {
+    return group_first_axis[lhs] < group_first_axis[rhs];
+  });
+
+  InlinedVector<size_t> input_position(num_groups);
+  simplified_input_dims.resize(num_groups);
+  for (size_t i = 0; i < num_groups; ++i) {
+    input_position[input_order[i]] = i;
+    simplified_input_dims[i] = group_dims[input_order[i]];
+  }
+
+  simplified_permutations.resize(num_groups);
+  simplified_output_dims.resize(num_groups);
+  for (size_t i = 0; i < num_groups; ++i) {
+    simplified_permutations[i] = input_position[i];
+    simplified_output_dims[i] = group_dims[i];
+  }
+
+  return true;
+}
+
 static Status TransposeImpl(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
                             const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   TensorShape shape = input_shape_override ? *input_shape_override : input.Shape();
@@ -359,6 +431,19 @@ static Status TransposeImpl(const gsl::span<const size_t>& permutations, const T
     return Status::OK();
   }
 
+  InlinedVector<size_t> simplified_permutations;
+  TensorShapeVector simplified_input_dims;
+  TensorShapeVector simplified_output_dims;
+  if (SimplifyTranspose(permutations, shape.GetDims(), simplified_permutations, simplified_input_dims,
+                        simplified_output_dims)) {
+    // Run on views of the input and output with the simplified shapes. The simplified permutation can not be
+    // simplified any further, so this recurses only once.
+    const TensorShape simplified_input_shape(simplified_input_dims);
+    Tensor simplified_output(output.DataType(), TensorShape(simplified_output_dims), output.MutableDataRaw(),
+                             output.Location());
+    return TransposeImpl(simplified_permutations, input, simplified_output, &simplified_input_shape, tp);
+  }
+
   size_t from = 0, to = 0;
   bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
 
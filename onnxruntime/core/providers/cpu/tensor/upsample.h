@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <type_traits>
+#include <utility>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -101,6 +103,64 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
+  if constexpr (std::is_same_v<T, float>) {
+    if (!use_extrapolation) {
+      // Bilinear interpolation is separable: interpolate each needed input row along x once, then blend the two
+      // rows along y. Consecutive output rows usually map to the same input rows, so the horizontal pass is shared
+      // between them, and both passes are contiguous loops the compiler can vectorize. Integer types keep the
+      // per-pixel path below so the truncation to T is bit-exact with the previous results.
+      for (int32_t n = 0; n < batch_size; ++n) {
+        concurrency::ThreadPool::TrySimpleParallelFor(
+            tp, num_channels,
+            [&](std::ptrdiff_t c) {
+              const float* const Xdata =
+                  XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
+              float* const Ydata =
+                  YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
+
+              std::vector<float> rows(2 * static_cast<size_t>(output_width));
+              float* row1 = rows.data();
+              float* row2 = rows.data() + output_width;
+              int32_t row1_offset = -1;
+              int32_t row2_offset = -1;
+
+              auto interpolate_row = [&](int32_t input_offset, float* row) {
+                const float* const input_row = Xdata + input_offset;
+                for (int32_t x = 0; x < output_width; ++x) {
+                  row[x] = p.dx2[x] * input_row[p.in_x1[x]] + p.dx1[x] * input_row[p.in_x2[x]];
+                }
+              };
+
+              for (int32_t y = 0; y < output_height; ++y) {
+                const int32_t y1_offset = p.input_width_mul_y1[y];
+                const int32_t y2_offset = p.input_width_mul_y2[y];
+                if (y1_offset != row1_offset) {
+                  if (y1_offset == row2_offset) {
+                    std::swap(row1, row2);
+                    std::swap(row1_offset, row2_offset);
+                  } else {
+                    interpolate_row(y1_offset, row1);
+                    row1_offset = y1_offset;
+                  }
+                }
+                if (y2_offset != row2_offset) {
+                  interpolate_row(y2_offset, row2);
+                  row2_offset = y2_offset;
+                }
+
+                const float dy1 = p.dy1[y];
+                const float dy2 = p.dy2[y];
+                float* const output_row = Ydata + output_width * y;
+                for (int32_t x = 0; x < output_width; ++x) {
+                  output_row[x] = dy2 * row1[x] + dy1 * row2[x];
+                }
+              }
+            });
+      }
+      return;
+    }
+  }
+
   for (int32_t n = 0; n < batch_size; ++n) {
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, num_channels,
@@ -3,6 +3,7 @@
 
 #include "regex_full_match.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
@@ -21,14 +22,17 @@ Status RegexFullMatch::Compute(OpKernelContext* context) const {
   const auto* input_tensor = context->Input<Tensor>(0);
   const auto input_data = input_tensor->template DataAsSpan<std::string>();
   auto* output_tensor = context->Output(0, input_tensor->Shape());
-  auto output_data = output_tensor->template MutableDataAsSpan<bool>();
-  auto output_iter = output_data.begin();
-  auto input_iter = input_data.begin();
-  while (input_iter != input_data.end()) {
-    *output_iter = RE2::FullMatch(*input_iter, re_);
-    input_iter++;
-    output_iter++;
-  }
+  auto* output_data = output_tensor->template MutableData<bool>();
+  const auto* input_strings = input_data.data();
+  // RE2 is thread-safe for matching, so elements are matched in parallel.
+  // The cost is a rough estimate for matching a short string with the precompiled DFA.
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(input_data.size()), 1024.0,
+      [this, input_strings, output_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          output_data[i] = RE2::FullMatch(input_strings[i], re_);
+        }
+      });
   return Status::OK();
 }
 
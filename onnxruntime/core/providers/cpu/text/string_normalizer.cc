@@ -3,6 +3,7 @@
 
 #include "string_normalizer.h"
 #include "core/common/common.h"
+#include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
 // Used below HAS_DEPRECATED_DECLARATIONS
 #include "onnxruntime_config.h"
@@ -12,6 +13,8 @@
 #include <locale.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
+#include <array>
 #include <codecvt>
 #include <locale>
 #include <functional>
@@ -436,6 +439,38 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 #endif
 
 #endif  // _MSC_VER
+
+// Case mapping of the 7-bit ASCII range under a given locale. ASCII-only strings can be
+// case changed byte by byte with it, skipping the UTF-8 <-> wchar_t round trip.
+// Only usable if the locale maps every ASCII character to an ASCII character.
+class AsciiCaseTable {
+ public:
+  AsciiCaseTable(const Locale& locale, StringNormalizer::CaseAction caseaction) {
+    if (caseaction == StringNormalizer::NONE) {
+      return;
+    }
+
+    std::wstring wstr(table_.size(), L'\0');
+    for (size_t i = 0; i < table_.size(); ++i) {
+      wstr[i] = static_cast<wchar_t>(i);
+    }
+    locale.ChangeCase(caseaction, wstr);
+
+    valid_ = std::all_of(wstr.cbegin(), wstr.cend(), [](wchar_t ch) { return static_cast<uint32_t>(ch) < 0x80; });
+    for (size_t i = 0; i < table_.size(); ++i) {
+      table_[i] = static_cast<char>(wstr[i]);
+    }
+  }
+
+  bool IsValid() const { return valid_; }
+
+  char Map(char ch) const { return table_[static_cast<unsigned char>(ch)]; }
+
+ private:
+  std::array<char, 0x80> table_{};
+  bool valid_ = false;
+};
+
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -525,13 +560,19 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
 
   Locale locale(locale_name_);
   Utf8Converter converter;
+  const AsciiCaseTable ascii_change_case(locale, case_change_action_);
+  const AsciiCaseTable ascii_compare_case(locale, is_case_sensitive_ ? NONE : compare_caseaction_);
 
   // Compute the largest widestring buffer needed.
   size_t max_wide_buffer_len = 0;
   for (const auto& s : input_span) {
     size_t wchars = 0;
-    // Checks for invalid UTF-8 characters on Windows
-    ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
+    if (utf8_util::is_ascii(s.data(), s.size())) {
+      wchars = s.size();
+    } else {
+      // Checks for invalid UTF-8 characters on Windows
+      ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
+    }
     max_wide_buffer_len = std::max(max_wide_buffer_len, wchars);
   }
 
@@ -539,20 +580,28 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   std::wstring wchar_buffer;
   wchar_buffer.reserve(max_wide_buffer_len);
 
+  auto change_case = [&](const std::string& s, std::string& dest) {
+    if (ascii_change_case.IsValid() && utf8_util::is_ascii(s.data(), s.size())) {
+      dest.resize(s.size());
+      std::transform(s.cbegin(), s.cend(), dest.begin(), [&](char ch) { return ascii_change_case.Map(ch); });
+      return Status::OK();
+    }
+
+    wchar_buffer.resize(max_wide_buffer_len);
+    ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+    locale.ChangeCase(case_change_action_, wchar_buffer);
+
+    size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
+    dest.resize(utf8_buffer_len);
+    return converter.ConvertToUtf8(wchar_buffer, dest);
+  };
+
   // Output everything and change case as required
   auto output_no_filtering = [&](const TensorShape& output_shape) {
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
     for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-      const std::string& s = input_span[i];
-      wchar_buffer.resize(max_wide_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
-
-      auto& dest = output_data[i];
-      size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-      dest.resize(utf8_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
+      ORT_RETURN_IF_ERROR(change_case(input_span[i], output_data[i]));
     }
     return Status::OK();
   };
@@ -563,14 +612,7 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     for (size_t i : filtered_indices) {
       const std::string& s = input_span[i];
       if (case_change_action_ != NONE) {
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
-
-        auto& dest = *output_data++;
-        size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-        dest.resize(utf8_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
+        ORT_RETURN_IF_ERROR(change_case(s, *output_data++));
       } else {
         *output_data++ = s;
       }
@@ -616,9 +658,15 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       filtered_strings_indices.reserve(input_span.size());
       for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
         const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
+        if (ascii_compare_case.IsValid() && utf8_util::is_ascii(s.data(), s.size())) {
+          wchar_buffer.resize(s.size());
+          std::transform(s.cbegin(), s.cend(), wchar_buffer.begin(),
+                         [&](char ch) { return static_cast<wchar_t>(ascii_compare_case.Map(ch)); });
+        } else {
+          wchar_buffer.resize(max_wide_buffer_len);
+          ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+          locale.ChangeCase(compare_caseaction_, wchar_buffer);
+        }
         if (wstopwords_.count(wchar_buffer) == 0) {
           filtered_strings_indices.push_back(i);
         }
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 #include "core/common/common.h"
 namespace onnxruntime {
 
@@ -69,14 +70,21 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
   auto num_tokens_iter = num_tokens_data.begin();
 
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
+  // All substrings are kept in one flat buffer of views into the input. Substrings of input i are
+  // [substr_offsets[i], substr_offsets[i + 1]), so no per-element container is allocated.
+  // The token count is not known before splitting, so the buffer is reserved for one substring per input and
+  // grows geometrically when inputs have more tokens.
+  InlinedVector<std::string_view> substrs;
+  substrs.reserve(input_data.size());
+  std::vector<size_t> substr_offsets;
+  substr_offsets.reserve(input_data.size() + 1);
+  substr_offsets.push_back(0);
   size_t last_dim = 0;
 
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
     ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
+    auto substr_count = substrs.size() - substr_offsets.back();
+    substr_offsets.push_back(substrs.size());
     last_dim = std::max(last_dim, substr_count);
     *num_tokens_iter = static_cast<int64_t>(substr_count);
     ++num_tokens_iter;
@@ -87,9 +95,9 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  auto offsets_iter = substr_offsets.begin();
+  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++offsets_iter) {
+    std::copy(substrs.begin() + *offsets_iter, substrs.begin() + *(offsets_iter + 1), output_splits_iter);
   }
 
   return Status::OK();
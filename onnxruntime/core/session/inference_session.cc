@@ -71,6 +71,7 @@
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/optimized_model_cache.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/session/user_logging_sink.h"
@@ -1007,6 +1008,14 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
     ORT_RETURN_IF_ERROR(AddCustomOpDomains(domain_ptrs));
 #endif
 
+    if (IsOptimizedModelCacheEnabled()) {
+      auto status = optimized_model_cache::FingerprintModelFile(model_location_,
+                                                                optimized_model_cache_model_fingerprint_);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "The optimized model cache is not used. " << status.ErrorMessage();
+      }
+    }
+
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
@@ -1079,6 +1088,11 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
   }
 
   auto loader = [this, model_data, model_data_len](std::shared_ptr<onnxruntime::Model>& model) {
+    if (IsOptimizedModelCacheEnabled()) {
+      optimized_model_cache_model_fingerprint_ =
+          optimized_model_cache::FingerprintModelBytes(model_data, static_cast<size_t>(model_data_len));
+    }
+
     ModelProto model_proto;
 
     const bool result = model_proto.ParseFromArray(model_data, model_data_len);
@@ -1789,6 +1803,109 @@ common::Status InferenceSession::HasInvalidCombinationOfExecutionProviders() con
   return Status::OK();
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+bool InferenceSession::IsOptimizedModelCacheEnabled() const {
+  return !session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "").empty();
+}
+
+Status InferenceSession::LoadFromOptimizedModelCache(bool have_cpu_ep) {
+  if (!IsOptimizedModelCacheEnabled() || optimized_model_cache_model_fingerprint_.empty()) {
+    return Status::OK();
+  }
+
+  // these replace initializers of the loaded model, so the optimized graph of the model on its own does not apply
+  if (!session_options_.external_initializers.empty() ||
+      !session_options_.external_initializer_files_mmap.empty()) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used as the session provides initializers.";
+    return Status::OK();
+  }
+
+  std::string model_fingerprint = optimized_model_cache_model_fingerprint_;
+  Status status = optimized_model_cache::AddExternalDataFingerprints(model_->MainGraph(), model_location_,
+                                                                     model_fingerprint);
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "The optimized model cache is not used. " << status.ErrorMessage();
+    return Status::OK();
+  }
+
+  // the default CPU EP is registered later in Initialize if the user did not add one
+  std::vector<std::string> execution_provider_types = execution_providers_.GetIds();
+  if (!have_cpu_ep) {
+    execution_provider_types.push_back(kCpuExecutionProvider);
+  }
+
+  const PathString cache_dir = ToPathString(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, ""));
+  std::string entry_key = optimized_model_cache::GetEntryKey(model_fingerprint,
+                                                             optimized_model_cache::FingerprintHardware(),
+                                                             execution_provider_types,
+                                                             execution_providers_.GetAllProviderOptions(),
+                                                             session_options_, optimizers_to_disable_);
+  PathString entry_path = optimized_model_cache::GetEntryPath(cache_dir, entry_key);
+
+  if (!Env::Default().FileExists(entry_path)) {
+    LOGS(*session_logger_, INFO) << "No optimized model cache entry. The optimized model will be saved to "
+                                 << ToUTF8String(entry_path);
+    optimized_model_cache_entry_path_ = std::move(entry_path);
+    optimized_model_cache_entry_key_ = std::move(entry_key);
+    return Status::OK();
+  }
+
+  const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
+                                               kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+  std::shared_ptr<onnxruntime::Model> cached_model;
+  ORT_TRY {
+    status = onnxruntime::Model::Load(entry_path, cached_model,
+                                      HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
+                                      ModelOptions(true, strict_shape_type_inference, check_load_cancellation_fn_));
+    if (status.IsOK()) {
+      status = optimized_model_cache::VerifyEntryKey(*cached_model, entry_key);
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Optimized model cache entry " << ToUTF8String(entry_path)
+                                    << " could not be loaded and will be replaced. " << status.ErrorMessage();
+    optimized_model_cache_entry_path_ = std::move(entry_path);
+    optimized_model_cache_entry_key_ = std::move(entry_key);
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Using optimized model cache entry " << ToUTF8String(entry_path);
+  model_ = std::move(cached_model);
+  model_location_ = std::move(entry_path);
+  loaded_from_optimized_model_cache_ = true;
+  return Status::OK();
+}
+
+void InferenceSession::SaveToOptimizedModelCache() {
+  // compiled nodes can not be serialized, and the entry would be invalid without them
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, INFO) << "The optimized model is not cached as it contains compiled nodes.";
+    return;
+  }
+
+  // a failure to write the cache only costs the next session the optimization time
+  Status status;
+  ORT_TRY {
+    status = optimized_model_cache::SaveEntry(*model_, optimized_model_cache_entry_path_,
+                                               optimized_model_cache_entry_key_);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to save the optimized model cache entry. " << status.ErrorMessage();
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // VC++ reports: "Releasing unheld lock 'l' in function 'onnxruntime::InferenceSession::Initialize'". But I don't see anything wrong.
@@ -1827,6 +1944,11 @@ common::Status InferenceSession::Initialize() {
       }
 
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
+
+#if !defined(ORT_MINIMAL_BUILD)
+      // this may replace model_ with a previously optimized copy, so it must happen before the graph is used
+      ORT_RETURN_IF_ERROR_SESSIONID_(LoadFromOptimizedModelCache(have_cpu_ep));
+#endif
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
@@ -1959,8 +2081,12 @@ common::Status InferenceSession::Initialize() {
       };
 
       // add predefined transformers
+      // a model from the optimized model cache has already been optimized for this session configuration
+      const TransformerLevel graph_optimization_level = loaded_from_optimized_model_cache_
+                                                            ? TransformerLevel::Default
+                                                            : session_options_.graph_optimization_level;
       ORT_RETURN_IF_ERROR_SESSIONID_(AddPredefinedTransformers(graph_transformer_mgr_,
-                                                               session_options_.graph_optimization_level,
+                                                               graph_optimization_level,
                                                                minimal_build_optimization_handling,
                                                                record_runtime_optimization_produced_op_schema,
                                                                *session_logger_));
@@ -2173,6 +2299,11 @@ common::Status InferenceSession::Initialize() {
 
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+
+      // The graph is final at this point. Save it before the session state takes the initializers.
+      if (!optimized_model_cache_entry_path_.empty() && !saving_ort_format) {
+        SaveToOptimizedModelCache();
+      }
 #else   // !defined(ORT_MINIMAL_BUILD)
       ORT_RETURN_IF_ERROR_SESSIONID_(
           ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
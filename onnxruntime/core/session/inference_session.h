@@ -689,6 +689,14 @@ class InferenceSession {
 
   [[nodiscard]] common::Status LoadOnnxModel(const PathString& model_uri);
 
+  bool IsOptimizedModelCacheEnabled() const;
+
+  // Replace model_ with the optimized model cache entry for this session if there is a valid one.
+  // Otherwise remember the entry path so that the optimized model is saved there by Initialize.
+  [[nodiscard]] common::Status LoadFromOptimizedModelCache(bool have_cpu_ep);
+
+  void SaveToOptimizedModelCache();
+
   bool HasLocalSchema() const {
     return !custom_schema_registries_.empty();
   }
@@ -783,6 +791,17 @@ class InferenceSession {
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
   InlinedHashSet<std::string> optimizers_to_disable_;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Fingerprint of the loaded ONNX model when the optimized model cache is enabled.
+  std::string optimized_model_cache_model_fingerprint_;
+
+  // Set when there is no valid cache entry for this session yet.
+  PathString optimized_model_cache_entry_path_;
+  std::string optimized_model_cache_entry_key_;
+
+  bool loaded_from_optimized_model_cache_ = false;
+#endif
+
   // session_options_ must be declared *before* session_state_ in order to guarantee that session_options_ is destroyed
   // *after* the session_state_. This destruction order ensures that the custom operator library handles stored within
   // the session options are released after the individual operators are destroyed.
@@ -0,0 +1,274 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/optimized_model_cache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor_external_data_info.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace optimized_model_cache {
+
+namespace {
+
+constexpr size_t kHashChunkSize = 1 << 20;
+
+// metadata_props entry of a cache entry that holds its key
+constexpr const char* kEntryKeyMetadataName = "onnxruntime.optimized_model_cache.key";
+
+// 128-bit hash that is updated by chaining MurmurHash3 calls. The whole state is carried between updates.
+class Hasher {
+ public:
+  void Update(const void* data, size_t size) {
+    uint32_t block[8];
+    std::copy(std::begin(hash_), std::end(hash_), block);
+    MurmurHash3::x86_128(data, size, 0, block + 4);
+    MurmurHash3::x86_128(block, sizeof(block), 0, hash_);
+  }
+
+  std::string ToString() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t value : hash_) {
+      ss << std::setw(8) << value;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+// Append a 'name=value' line to a key. Line breaks in the value are escaped so that fields can not run together.
+void AddField(std::string& key, std::string_view name, std::string_view value) {
+  key.append(name).append("=");
+  for (char c : value) {
+    if (c == '\\') {
+      key.append("\\\\");
+    } else if (c == '\n') {
+      key.append("\\n");
+    } else {
+      key.push_back(c);
+    }
+  }
+  key.push_back('\n');
+}
+
+template <typename T>
+std::vector<std::pair<std::string, std::string>> SortedEntries(const T& map) {
+  std::vector<std::pair<std::string, std::string>> entries(map.begin(), map.end());
+  std::sort(entries.begin(), entries.end());
+  return entries;
+}
+
+}  // namespace
+
+std::string FingerprintModelBytes(const void* model_data, size_t model_data_len) {
+  Hasher hasher;
+  const auto* bytes = static_cast<const char*>(model_data);
+  for (size_t offset = 0; offset < model_data_len; offset += kHashChunkSize) {
+    hasher.Update(bytes + offset, std::min(kHashChunkSize, model_data_len - offset));
+  }
+
+  std::string fingerprint;
+  AddField(fingerprint, "model_bytes", hasher.ToString());
+  return fingerprint;
+}
+
+Status FingerprintModelFile(const PathString& model_path, std::string& fingerprint) {
+  std::error_code error;
+  const auto path = std::filesystem::absolute(std::filesystem::path(model_path), error);
+  ORT_RETURN_IF(error, "Failed to get the absolute path of ", ToUTF8String(model_path), ": ", error.message());
+
+  const auto size = std::filesystem::file_size(path, error);
+  ORT_RETURN_IF(error, "Failed to get the size of ", ToUTF8String(model_path), ": ", error.message());
+
+  const auto write_time = std::filesystem::last_write_time(path, error);
+  ORT_RETURN_IF(error, "Failed to get the last write time of ", ToUTF8String(model_path), ": ", error.message());
+
+  fingerprint.clear();
+  AddField(fingerprint, "model_file", ToUTF8String(path.native()));
+  AddField(fingerprint, "model_file_size", std::to_string(size));
+  AddField(fingerprint, "model_file_write_time", std::to_string(write_time.time_since_epoch().count()));
+  return Status::OK();
+}
+
+Status AddExternalDataFingerprints(const Graph& graph, const PathString& model_path, std::string& fingerprint) {
+  std::vector<PathString> data_files;
+  for (const auto& [name, initializer] : graph.GetAllInitializedTensors()) {
+    if (!utils::HasExternalData(*initializer)) {
+      continue;
+    }
+
+    std::unique_ptr<ExternalDataInfo> external_data_info;
+    ORT_RETURN_IF_ERROR(ExternalDataInfo::Create(initializer->external_data(), external_data_info));
+    const auto& data_file = external_data_info->GetRelPath();
+    if (data_file != utils::kTensorProtoMemoryAddressTag) {
+      data_files.push_back(data_file);
+    }
+  }
+
+  std::sort(data_files.begin(), data_files.end());
+  data_files.erase(std::unique(data_files.begin(), data_files.end()), data_files.end());
+
+  const auto model_dir = std::filesystem::path(model_path).parent_path();
+  for (const auto& data_file : data_files) {
+    std::string data_fingerprint;
+    ORT_RETURN_IF_ERROR(FingerprintModelFile((model_dir / data_file).native(), data_fingerprint));
+    fingerprint += data_fingerprint;
+  }
+
+  return Status::OK();
+}
+
+std::string FingerprintHardware() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::string fingerprint;
+#if defined(CPUIDINFO_ARCH_X86)
+  AddField(fingerprint, "cpu_arch", "x86");
+  AddField(fingerprint, "cpu_avx", std::to_string(cpuid_info.HasAVX()));
+  AddField(fingerprint, "cpu_avx2", std::to_string(cpuid_info.HasAVX2()));
+  AddField(fingerprint, "cpu_avx512f", std::to_string(cpuid_info.HasAVX512f()));
+  AddField(fingerprint, "cpu_avx512_skylake", std::to_string(cpuid_info.HasAVX512Skylake()));
+#elif defined(CPUIDINFO_ARCH_ARM)
+  AddField(fingerprint, "cpu_arch", "arm");
+  AddField(fingerprint, "cpu_neon_dot", std::to_string(cpuid_info.HasArmNeonDot()));
+  AddField(fingerprint, "cpu_neon_i8mm", std::to_string(cpuid_info.HasArmNeon_I8MM()));
+  AddField(fingerprint, "cpu_neon_bf16", std::to_string(cpuid_info.HasArmNeon_BF16()));
+#else
+  ORT_UNUSED_PARAMETER(cpuid_info);
+  AddField(fingerprint, "cpu_arch", "other");
+#endif
+  AddField(fingerprint, "nchwc_block_size", std::to_string(MlasNchwcGetBlockSize()));
+  return fingerprint;
+}
+
+std::string GetEntryKey(const std::string& model_fingerprint,
+                        const std::string& hardware_fingerprint,
+                        gsl::span<const std::string> execution_provider_types,
+                        const ProviderOptionsMap& provider_options,
+                        const SessionOptions& session_options,
+                        const InlinedHashSet<std::string>& optimizers_to_disable) {
+  std::string key = model_fingerprint;
+  key += hardware_fingerprint;
+  AddField(key, "ort_version", ORT_VERSION);
+
+  // the order of the providers is the partitioning priority, so it is part of the key
+  for (const auto& type : execution_provider_types) {
+    AddField(key, "execution_provider", type);
+    auto options = provider_options.find(type);
+    if (options != provider_options.end()) {
+      for (const auto& [name, value] : SortedEntries(options->second)) {
+        AddField(key, "provider_option." + name, value);
+      }
+    }
+  }
+
+  AddField(key, "graph_optimization_level",
+           std::to_string(static_cast<int>(session_options.graph_optimization_level)));
+
+  std::vector<std::string> sorted_optimizers(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(sorted_optimizers.begin(), sorted_optimizers.end());
+  for (const auto& name : sorted_optimizers) {
+    AddField(key, "disabled_optimizer", name);
+  }
+
+  for (const auto& free_dim : session_options.free_dimension_overrides) {
+    AddField(key, "free_dimension_override",
+             std::to_string(static_cast<int>(free_dim.dim_identifier_type)) + ":" + free_dim.dim_identifier + "=" +
+                 std::to_string(free_dim.dim_value));
+  }
+
+  for (const auto& [name, value] : SortedEntries(session_options.config_options.GetConfigOptionsMap())) {
+    if (name != kOrtSessionOptionsOptimizedModelCacheDir) {
+      AddField(key, "config." + name, value);
+    }
+  }
+
+  return key;
+}
+
+PathString GetEntryPath(const PathString& cache_dir, const std::string& entry_key) {
+  Hasher hasher;
+  hasher.Update(entry_key.data(), entry_key.size());
+  return (std::filesystem::path(cache_dir) / (hasher.ToString() + ".onnx")).native();
+}
+
+Status SaveEntry(Model& model, const PathString& entry_path, const std::string& entry_key) {
+  const std::filesystem::path path(entry_path);
+  std::error_code error;
+  std::filesystem::create_directories(path.parent_path(), error);
+  ORT_RETURN_IF(error, "Failed to create optimized model cache directory ", path.parent_path().string(), ": ",
+                error.message());
+
+  // write the entry to a directory of its own so that concurrent sessions saving the same entry do not share files.
+  // the data file name is relative, so the model references the final data file once both are moved into place.
+  std::filesystem::path temp_dir = path;
+  temp_dir += ORT_TSTR(".") + ToPathString(std::to_string(Env::Default().GetSelfPid())) + ORT_TSTR(".") +
+              ToPathString(std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()))) +
+              ORT_TSTR(".tmp");
+  std::filesystem::create_directory(temp_dir, error);
+  ORT_RETURN_IF(error, "Failed to create directory ", temp_dir.string(), ": ", error.message());
+  auto remove_temp_dir = gsl::finally([&temp_dir]() {
+    std::error_code remove_error;
+    std::filesystem::remove_all(temp_dir, remove_error);
+  });
+
+  const std::filesystem::path data_file_name = path.filename().native() + ORT_TSTR(".data");
+  const std::filesystem::path temp_path = temp_dir / path.filename();
+  const std::filesystem::path temp_data_path = temp_dir / data_file_name;
+
+  {
+    // the key is only needed in the file, so it is removed from the session's model once the entry is written
+    model.SetMetaDataEntry(kEntryKeyMetadataName, entry_key);
+    auto remove_key = gsl::finally([&model]() { model.RemoveMetaDataEntry(kEntryKeyMetadataName); });
+
+    ModelSavingOptions saving_options{1024};
+    saving_options.align_offset = true;
+    ORT_RETURN_IF_ERROR(Model::SaveWithExternalInitializers(model, temp_path, data_file_name, saving_options));
+  }
+
+  // the data file is moved first, so a model file in the cache never references a data file that is missing
+  if (std::filesystem::exists(temp_data_path, error)) {
+    std::filesystem::rename(temp_data_path, path.parent_path() / data_file_name, error);
+  }
+  if (!error) {
+    std::filesystem::rename(temp_path, path, error);
+  }
+  ORT_RETURN_IF(error, "Failed to write optimized model cache entry ", path.string(), ": ", error.message());
+
+  return Status::OK();
+}
+
+Status VerifyEntryKey(Model& model, const std::string& entry_key) {
+  const auto& metadata = model.MetaData();
+  auto key = metadata.find(kEntryKeyMetadataName);
+  ORT_RETURN_IF(key == metadata.end(), "The entry has no key.");
+  ORT_RETURN_IF(key->second != entry_key, "The entry was saved for a different model or session configuration.");
+
+  model.RemoveMetaDataEntry(kEntryKeyMetadataName);
+  return Status::OK();
+}
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/framework/provider_options.h"
+#include "core/framework/session_options.h"
+
+namespace onnxruntime {
+class Graph;
+class Model;
+
+/**
+Cache of optimized ONNX format models, enabled with the session.optimized_model_cache_dir config entry.
+
+An entry is an optimized model saved with external initializers. Its key describes everything that changes the
+optimized graph: the model, the CPU features and NCHWc block size, the ORT version, the execution providers and
+their options, the optimization level, the disabled optimizers and the session config. The entry is named after a hash of the key, and the key itself is
+stored in the metadata_props of the entry and compared on load, so a hash collision or a stale file can not be
+mistaken for a valid entry. Both files of an entry are written to a temporary directory and renamed into place,
+the model file last, so an entry is either complete or ignored.
+*/
+namespace optimized_model_cache {
+
+// Fingerprint of a model loaded from memory: a hash of the model bytes.
+std::string FingerprintModelBytes(const void* model_data, size_t model_data_len);
+
+// Fingerprint of a model file: its absolute path, size and last write time. The file is not read, so this is cheap
+// for large models, and rewriting the file invalidates its entries.
+Status FingerprintModelFile(const PathString& model_path, std::string& fingerprint);
+
+// Add the fingerprints of the external data files of the initializers of the graph, so that an entry is not used
+// after the weights change. Paths are relative to the directory of model_path.
+Status AddExternalDataFingerprints(const Graph& graph, const PathString& model_path, std::string& fingerprint);
+
+// Fingerprint of the CPU the process runs on: its architecture, the ISA extensions MLAS dispatches on and the NCHWc
+// block size. Layout optimizations reorder weights for these, so an entry is only valid on matching hardware.
+std::string FingerprintHardware();
+
+// Key of the cache entry for the model with the given fingerprint in a session with the given providers and options,
+// on hardware with the given fingerprint.
+std::string GetEntryKey(const std::string& model_fingerprint,
+                        const std::string& hardware_fingerprint,
+                        gsl::span<const std::string> execution_provider_types,
+                        const ProviderOptionsMap& provider_options,
+                        const SessionOptions& session_options,
+                        const InlinedHashSet<std::string>& optimizers_to_disable);
+
+// Path of the cache entry with the given key.
+PathString GetEntryPath(const PathString& cache_dir, const std::string& entry_key);
+
+// Save the optimized model as the cache entry with the given key. Initializers are stored in
+// '<entry file name>.data' next to it.
+Status SaveEntry(Model& model, const PathString& entry_path, const std::string& entry_key);
+
+// Check that a loaded cache entry was saved with the given key, and remove the key from the model metadata.
+Status VerifyEntryKey(Model& model, const std::string& entry_key);
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -963,11 +963,63 @@ class DefaultWeightOnlyQuantizer:
         scales = scales.reshape(scales_shape)
         return quant_data_int4, scales, zero_point_int4
 
+    @staticmethod
+    def quantize_ndarray_8bits(
+        data: np.ndarray,
+        quantize_axis: int,
+        block_size: int,
+        is_symmetric: bool,
+    ) -> tuple[np.ndarray, np.ndarray, np.ndarray | None]:
+        """Quantize ndarray data to uint8 using numpy, return (quantized data, scales, zero points).
+        Symmetric quantization stores the values offset by 128, which is the default zero point of 8 bits
+        GatherBlockQuantized, so no zero points are returned in that case.
+        """
+        k = data.shape[quantize_axis]
+        k_blocks = (k + block_size - 1) // block_size
+        scales_shape = list(data.shape)
+        scales_shape[quantize_axis] = k_blocks
+
+        # pad the quantize axis to whole blocks and move it next to the block axis: (..., k_blocks, block_size, ...)
+        pad = [(0, 0)] * data.ndim
+        pad[quantize_axis] = (0, k_blocks * block_size - k)
+        padded = np.pad(data, pad)
+        blocked_shape = list(data.shape)
+        blocked_shape[quantize_axis : quantize_axis + 1] = [k_blocks, block_size]
+        blocked = padded.reshape(blocked_shape)
+        block_axis = quantize_axis + 1
+
+        if is_symmetric:
+            max_val = np.max(blocked, axis=block_axis, keepdims=True)
+            min_val = np.min(blocked, axis=block_axis, keepdims=True)
+            abs_max = np.where(np.abs(max_val) > np.abs(min_val), max_val, min_val)
+            scale = abs_max / -128.0
+            quantized = np.where(scale == 0, 0, blocked / np.where(scale == 0, 1, scale)).round().clip(-128, 127)
+            quantized = (quantized + 128).astype(np.uint8)
+            zero_point = None
+        else:
+            min_val = np.minimum(blocked.min(axis=block_axis, keepdims=True), 0)
+            max_val = np.maximum(blocked.max(axis=block_axis, keepdims=True), 0)
+            scale = (max_val - min_val) / 255.0
+            safe_scale = np.where(scale == 0, 1, scale)
+            zero_point = np.where(scale == 0, 128, -min_val / safe_scale).round().clip(0, 255)
+            quantized = np.where(scale == 0, 128, blocked / safe_scale + zero_point).round().clip(0, 255)
+            quantized = quantized.astype(np.uint8)
+            zero_point = zero_point.astype(np.uint8).reshape(scales_shape)
+
+        quantized = quantized.reshape(padded.shape)
+        quantized = np.take(quantized, np.arange(k), axis=quantize_axis)
+        scales = scale.astype(data.dtype).reshape(scales_shape)
+        return np.ascontiguousarray(quantized), scales, zero_point
+
     def quantize_gather(self, node: NodeProto, graph_stack: list[GraphProto]) -> list[NodeProto]:
-        """Quantize weight data of Gather node to int4."""
+        """Quantize weight data of Gather node to int4 or uint8."""
         assert self.config.quant_format == QuantFormat.QOperator, "Gather only supports QOperator format currently."
 
-        qtype = TensorProto.INT4 if self.config.is_symmetric else TensorProto.UINT4
+        bits = self.config.bits
+        if bits == 8:
+            qtype = TensorProto.UINT8
+        else:
+            qtype = TensorProto.INT4 if self.config.is_symmetric else TensorProto.UINT4
         data_arg = node.input[0]
         data_tensorproto, data_graphproto = get_initializer(data_arg, graph_stack)
         if data_tensorproto is None:
@@ -983,9 +1035,14 @@ class DefaultWeightOnlyQuantizer:
         assert block_size >= 16 and ((block_size - 1) & block_size == 0), "Invalid block size for Gather node."
 
         quantize_axis = (quantize_axis + data_rank) % data_rank
-        quantized_data, scales, zero_points = self.quantize_ndarray(
-            data_ndarray, quantize_axis, block_size, self.config.is_symmetric
-        )
+        if bits == 8:
+            quantized_data, scales, zero_points = self.quantize_ndarray_8bits(
+                data_ndarray, quantize_axis, block_size, self.config.is_symmetric
+            )
+        else:
+            quantized_data, scales, zero_points = self.quantize_ndarray(
+                data_ndarray, quantize_axis, block_size, self.config.is_symmetric
+            )
 
         for input in data_graphproto.input:
             if input.name == data_arg:
@@ -993,12 +1050,12 @@ class DefaultWeightOnlyQuantizer:
                 break
 
         quantized_data_tensorproto = onnx.helper.make_tensor(
-            data_tensorproto.name + "_Q4", qtype, data_ndarray.shape, quantized_data.tobytes(), True
+            data_tensorproto.name + f"_Q{bits}", qtype, data_ndarray.shape, quantized_data.tobytes(), True
         )
         scales_tensorproto = onnx.numpy_helper.from_array(scales, data_tensorproto.name + "_scales")
         input_names = [quantized_data_tensorproto.name, node.input[1], scales_tensorproto.name]
         data_graphproto.initializer.extend([quantized_data_tensorproto, scales_tensorproto])
-        if not self.config.is_symmetric:
+        if zero_points is not None:
             zp_tensorproto = onnx.helper.make_tensor(
                 data_tensorproto.name + "_zero_points", qtype, scales.shape, zero_points.tobytes(), True
             )
@@ -1015,17 +1072,19 @@ class DefaultWeightOnlyQuantizer:
             "quantize_axis": quantize_axis,
             "block_size": block_size,
         }
+        if bits == 8:
+            kwargs["bits"] = bits
 
-        gather_q4_node = onnx.helper.make_node(
+        gather_q_node = onnx.helper.make_node(
             "GatherBlockQuantized",
             inputs=input_names,
             outputs=[node.output[0]],
-            name=node.name + "_Q4" if node.name else "",
+            name=node.name + f"_Q{bits}" if node.name else "",
             domain="com.microsoft",
             **kwargs,
         )
 
-        return [gather_q4_node]
+        return [gather_q_node]
 
     def quantize(self, node: NodeProto, graph_stack: list[GraphProto]) -> list[NodeProto]:
         """
@@ -1048,8 +1107,8 @@ class DefaultWeightOnlyQuantizer:
                 return [node]
             results = self.quantize_matmul(node, graph_stack)
         elif node.op_type == "Gather":
-            if self.config.bits != 4:
-                logger.error("Gather only supports 4 bits quantization.")
+            if self.config.bits not in (4, 8):
+                logger.error("Gather only supports 4 or 8 bits quantization.")
                 return [node]
 
             results = self.quantize_gather(node, graph_stack)
@@ -41,5 +41,19 @@ TEST(Utf8UtilTest, Validate) {
   }
 }
 
+TEST(Utf8UtilTest, IsAscii) {
+  using namespace utf8_util;
+  ASSERT_TRUE(is_ascii("", 0));
+  const std::string ascii = "The quick brown fox jumps over the lazy dog";
+  ASSERT_TRUE(is_ascii(ascii.data(), ascii.size()));
+
+  // a non-ASCII byte is found in the eight byte blocks and in the remaining bytes
+  for (size_t pos = 0; pos < ascii.size(); ++pos) {
+    std::string s = ascii;
+    s[pos] = '\xc3';
+    ASSERT_FALSE(is_ascii(s.data(), s.size())) << pos;
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
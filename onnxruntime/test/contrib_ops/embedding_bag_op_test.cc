@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+const std::vector<float> kTable = {1.f, 2.f,
+                                   3.f, 4.f,
+                                   5.f, 6.f};
+}  // namespace
+
+TEST(EmbeddingBagOpTest, SumWithOffsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, kTable);
+  test.AddInput<int64_t>("indices", {5}, {0, 2, 1, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {0, 2});
+  test.AddOutput<float>("output", {2, 2}, {6.f, 8.f, 11.f, 14.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, MeanWithoutOffsetsNegativeIndices) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("data", {3, 2}, kTable);
+  test.AddInput<int32_t>("indices", {2, 2}, {0, -1, 1, 0});
+  test.AddOutput<float>("output", {2, 2}, {3.f, 4.f, 2.f, 3.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, WeightedSumWithTrailingUnitDim) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, kTable);
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 1, 2, 2});
+  test.AddOptionalInputEdge<int64_t>();
+  test.AddInput<float>("per_sample_weights", {2, 2, 1}, {1.f, 0.5f, 2.f, -1.f});
+  test.AddOutput<float>("output", {2, 2}, {2.5f, 4.f, 5.f, 6.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, MeanWithEmptyBags) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("data", {3, 2}, kTable);
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 2});
+  test.AddInput<int64_t>("offsets", {3}, {0, 0, 3});
+  test.AddOutput<float>("output", {3, 2}, {0.f, 0.f, 3.f, 4.f, 0.f, 0.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Float16Sum) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<MLFloat16>("data", {3, 2}, ToFloat16(kTable));
+  test.AddInput<int64_t>("indices", {5}, {0, 2, 1, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {0, 2});
+  test.AddOutput<MLFloat16>("output", {2, 2}, ToFloat16({6.f, 8.f, 11.f, 14.f}));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, IndexOutOfBounds) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, kTable);
+  test.AddInput<int64_t>("indices", {2}, {0, 3});
+  test.AddInput<int64_t>("offsets", {1}, {0});
+  test.AddOutput<float>("output", {1, 2}, {0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+TEST(EmbeddingBagOpTest, DecreasingOffsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, kTable);
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {2, 1});
+  test.AddOutput<float>("output", {2, 2}, {0.f, 0.f, 0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "offsets must be non-decreasing");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
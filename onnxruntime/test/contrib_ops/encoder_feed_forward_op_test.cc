@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// batch_size = 1, sequence_length = 3, hidden_size = 4, intermediate_size = 6
+const std::vector<float> kInput = {0.1f, 0.43f, 0.21f, 0.09f,
+                                   -0.15f, 0.29f, -0.12f, 0.78f,
+                                   0.93f, -0.23f, 0.58f, 0.06f};
+const std::vector<float> kWeight1 = {0.14f, 0.85f, -0.86f, -0.83f, -0.96f, 0.67f,
+                                     0.56f, 0.74f, 0.96f, 0.6f, -0.08f, 0.56f,
+                                     -0.76f, 0.28f, -0.71f, 0.89f, 0.04f, -0.17f,
+                                     -0.47f, 0.55f, -0.09f, 0.14f, -0.96f, 0.24f};
+const std::vector<float> kBias1 = {0.22f, 0.23f, 0.89f, 0.36f, -0.28f, -0.13f};
+const std::vector<float> kWeight2 = {0.4f, -0.88f, 0.33f, 0.34f,
+                                     -0.58f, -0.74f, -0.37f, -0.27f,
+                                     0.14f, -0.12f, 0.98f, -0.8f,
+                                     -0.58f, -0.68f, 0.31f, -0.49f,
+                                     -0.07f, -0.51f, -0.68f, -0.78f,
+                                     0.31f, -0.72f, -0.61f, -0.26f};
+const std::vector<float> kGamma = {0.64f, -0.81f, 0.68f, -0.81f};
+const std::vector<float> kBeta = {0.95f, -0.06f, 0.95f, 0.21f};
+const std::vector<float> kBias2 = {0.48f, -0.92f, -0.43f, -0.76f};
+}  // namespace
+
+// Same as SkipLayerNormalization(input, MatMul(BiasGelu(MatMul(input, weight1), bias1), weight2), gamma, beta, bias2).
+TEST(EncoderFeedForwardTest, Gelu) {
+  for (bool constant_weights : {false, true}) {
+    OpTester test("EncoderFeedForward", 1, onnxruntime::kMSDomain);
+    test.AddInput<float>("input", {1, 3, 4}, kInput);
+    test.AddInput<float>("weight1", {4, 6}, kWeight1, constant_weights);
+    test.AddInput<float>("bias1", {6}, kBias1, constant_weights);
+    test.AddInput<float>("weight2", {6, 4}, kWeight2, constant_weights);
+    test.AddInput<float>("gamma", {4}, kGamma, constant_weights);
+    test.AddInput<float>("beta", {4}, kBeta, constant_weights);
+    test.AddInput<float>("bias2", {4}, kBias2, constant_weights);
+    test.AddOutput<float>("output", {1, 3, 4},
+                          {1.399569f, 0.681478f, 1.804540f, 1.055416f,
+                           1.302190f, 0.861500f, 1.867806f, 0.827509f,
+                           1.895037f, 1.002317f, 1.034803f, 0.444760f});
+    test.SetOutputTolerance(1e-4f);
+    test.Run();
+  }
+}
+
+TEST(EncoderFeedForwardTest, FastGeluWithoutBetaAndBias2) {
+  OpTester test("EncoderFeedForward", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("activation", "FastGelu");
+  test.AddInput<float>("input", {3, 4}, kInput);
+  test.AddInput<float>("weight1", {4, 6}, kWeight1, true);
+  test.AddInput<float>("bias1", {6}, kBias1);
+  test.AddInput<float>("weight2", {6, 4}, kWeight2, true);
+  test.AddInput<float>("gamma", {4}, kGamma);
+  test.AddOptionalInputEdge<float>();
+  test.AddOptionalInputEdge<float>();
+  test.AddOutput<float>("output", {3, 4},
+                        {-0.121646f, 0.451419f, 1.137323f, 0.749375f,
+                         -0.375914f, 0.558551f, 1.173486f, 0.363513f,
+                         0.723893f, 1.305001f, 0.210701f, -0.137842f});
+  test.SetOutputTolerance(1e-4f);
+  test.Run();
+}
+
+// With intermediate_size = 4096 a tile holds 16 rows, so the 100 rows are split into 7 tiles that the 2 threads of
+// the session each process several of. The expected output is computed in double precision.
+TEST(EncoderFeedForwardTest, MoreTilesThanWorkers) {
+  constexpr int64_t batch_size = 2, sequence_length = 50, hidden_size = 8, intermediate_size = 4096;
+  constexpr int64_t rows = batch_size * sequence_length;
+  constexpr float epsilon = 1e-5f;
+
+  RandomValueGenerator random{};
+  const std::vector<float> input = random.Uniform<float>(std::vector<int64_t>{rows, hidden_size}, -1.f, 1.f);
+  const std::vector<float> weight1 =
+      random.Uniform<float>(std::vector<int64_t>{hidden_size, intermediate_size}, -0.5f, 0.5f);
+  const std::vector<float> bias1 = random.Uniform<float>(std::vector<int64_t>{intermediate_size}, -0.5f, 0.5f);
+  const std::vector<float> weight2 =
+      random.Uniform<float>(std::vector<int64_t>{intermediate_size, hidden_size}, -0.05f, 0.05f);
+  const std::vector<float> gamma = random.Uniform<float>(std::vector<int64_t>{hidden_size}, 0.5f, 1.5f);
+  const std::vector<float> beta = random.Uniform<float>(std::vector<int64_t>{hidden_size}, -0.5f, 0.5f);
+  const std::vector<float> bias2 = random.Uniform<float>(std::vector<int64_t>{hidden_size}, -0.5f, 0.5f);
+
+  std::vector<float> expected_output(rows * hidden_size);
+  std::vector<double> activation(intermediate_size);
+  std::vector<double> row(hidden_size);
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t i = 0; i < intermediate_size; i++) {
+      double value = bias1[i];
+      for (int64_t h = 0; h < hidden_size; h++) {
+        value += static_cast<double>(input[r * hidden_size + h]) * weight1[h * intermediate_size + i];
+      }
+      activation[i] = 0.5 * value * (1.0 + std::erf(value / std::sqrt(2.0)));
+    }
+
+    double mean = 0.0;
+    for (int64_t h = 0; h < hidden_size; h++) {
+      double value = static_cast<double>(input[r * hidden_size + h]) + bias2[h];
+      for (int64_t i = 0; i < intermediate_size; i++) {
+        value += activation[i] * weight2[i * hidden_size + h];
+      }
+      row[h] = value;
+      mean += value;
+    }
+    mean /= hidden_size;
+
+    double variance = 0.0;
+    for (int64_t h = 0; h < hidden_size; h++) {
+      variance += (row[h] - mean) * (row[h] - mean);
+    }
+    variance /= hidden_size;
+
+    for (int64_t h = 0; h < hidden_size; h++) {
+      expected_output[r * hidden_size + h] =
+          static_cast<float>((row[h] - mean) / std::sqrt(variance + epsilon) * gamma[h] + beta[h]);
+    }
+  }
+
+  OpTester test("EncoderFeedForward", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input);
+  test.AddInput<float>("weight1", {hidden_size, intermediate_size}, weight1, true);
+  test.AddInput<float>("bias1", {intermediate_size}, bias1);
+  test.AddInput<float>("weight2", {intermediate_size, hidden_size}, weight2, true);
+  test.AddInput<float>("gamma", {hidden_size}, gamma);
+  test.AddInput<float>("beta", {hidden_size}, beta);
+  test.AddInput<float>("bias2", {hidden_size}, bias2);
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, expected_output);
+  test.SetOutputTolerance(1e-4f);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 2;
+
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(EncoderFeedForwardTest, InvalidWeight2Shape) {
+  OpTester test("EncoderFeedForward", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("input", {3, 4}, kInput);
+  test.AddInput<float>("weight1", {4, 6}, kWeight1);
+  test.AddInput<float>("bias1", {6}, kBias1);
+  test.AddInput<float>("weight2", {4, 6}, kWeight2);
+  test.AddInput<float>("gamma", {4}, kGamma);
+  test.AddOutput<float>("output", {3, 4}, std::vector<float>(12, 0.f));
+  test.Run(OpTester::ExpectResult::kExpectFailure,
+           "weight2 is expected to have shape (intermediate_size, hidden_size)");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Y = (A + B) * A with B broadcast over the rows of A.
+TEST(FusedElementwiseTest, AddMulBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, -1, 2, 0, -1});
+  test.AddInput<float>("A", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("B", {3}, {0.5f, -1.f, 2.f});
+  test.AddOutput<float>("Y", {2, 3}, {1.5f, 2.f, 15.f, 18.f, 20.f, 48.f});
+  test.Run();
+}
+
+// Y = Where(condition, Sqrt(X) - Tanh(Z), X)
+TEST(FusedElementwiseTest, WhereWithUnaryOps) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Sqrt", "Tanh", "Sub", "Where"});
+  test.AddAttribute("operands", std::vector<int64_t>{1, -1, -1, 2, -1, -1, 3, 4, -1, 0, 5, 1});
+  test.AddInput<bool>("condition", {2, 2}, {true, false, true, false});
+  test.AddInput<float>("X", {2, 2}, {0.25f, 4.f, 9.f, 16.f});
+  test.AddInput<float>("Z", {1}, {0.5f});
+  test.AddOutput<float>("Y", {2, 2}, {0.0378828f, 4.f, 2.5378828f, 16.f});
+  test.SetOutputTolerance(1e-5f);
+  test.Run();
+}
+
+// Y = Erf(X / B). The rows are longer than one chunk.
+TEST(FusedElementwiseTest, DivErfMultipleChunks) {
+  constexpr int64_t rows = 3;
+  constexpr int64_t columns = 300;
+  std::vector<float> x(rows * columns);
+  std::vector<float> b(columns);
+  std::vector<float> y(rows * columns);
+  for (int64_t c = 0; c < columns; ++c) {
+    b[c] = 1.f + static_cast<float>(c % 7);
+  }
+  for (int64_t i = 0; i < rows * columns; ++i) {
+    x[i] = static_cast<float>(i % 23 - 11) * 0.25f;
+    y[i] = std::erf(x[i] / b[i % columns]);
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Div", "Erf"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, -1, 2, -1, -1});
+  test.AddInput<float>("X", {rows, columns}, x);
+  test.AddInput<float>("B", {columns}, b);
+  test.AddOutput<float>("Y", {rows, columns}, y);
+  test.SetOutputTolerance(1e-5f);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, InvalidOperand) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 2, -1});
+  test.AddInput<float>("A", {2}, {1.f, 2.f});
+  test.AddInput<float>("B", {2}, {3.f, 4.f});
+  test.AddOutput<float>("Y", {2}, {4.f, 6.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Invalid operand 2 for step 0");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
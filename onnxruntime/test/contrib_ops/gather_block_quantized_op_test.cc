@@ -543,5 +543,68 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis2) {
   Test_GatherAxis2_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
 }
 
+// Row-wise quantized embedding table: one uint8 per element, two blocks per row with the last one partial.
+template <typename T2, typename Tind>
+void Test_GatherAxis0_8Bits(bool with_zero_points) {
+  constexpr int64_t rows = 3;
+  constexpr int64_t cols = 20;
+  constexpr int64_t block_size = 16;
+  constexpr int64_t blocks_per_row = 2;
+
+  std::vector<uint8_t> data;
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    data.push_back(static_cast<uint8_t>((i * 37) % 256));
+  }
+  std::vector<float> scales = {0.5f, 0.25f, 1.0f, 2.0f, 0.125f, 0.75f};
+  std::vector<uint8_t> zero_points = {128, 100, 0, 255, 64, 128};
+  std::vector<int> indices = {2, 0, 2};
+
+  std::vector<float> output;
+  for (int idx : indices) {
+    for (int64_t c = 0; c < cols; ++c) {
+      const int64_t scale_idx = idx * blocks_per_row + c / block_size;
+      const int zero_point = with_zero_points ? zero_points[scale_idx] : 128;
+      output.push_back(static_cast<float>(data[idx * cols + c] - zero_point) * scales[scale_idx]);
+    }
+  }
+
+  OpTester test("GatherBlockQuantized", 1, kMSDomain);
+  test.AddAttribute<int64_t>("gather_axis", 0);
+  test.AddAttribute<int64_t>("quantize_axis", 1);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", 8);
+  test.AddInput<uint8_t>("data", {rows, cols}, data);
+  test.AddInput<Tind>("indices", {3}, ToType<Tind>(indices));
+  test.AddInput<T2>("scales", {rows, blocks_per_row}, ToType<T2>(scales));
+  if (with_zero_points) {
+    test.AddInput<uint8_t>("zero_points", {rows, blocks_per_row}, zero_points);
+  }
+  test.AddOutput<T2>("output", {3, cols}, ToType<T2>(output));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> eps;
+  eps.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &eps);
+}
+
+TEST(GatherBlockQuantizedOpTest, GatherAxis0UInt8With8Bits) {
+  Test_GatherAxis0_8Bits<float, int32_t>(true);
+  Test_GatherAxis0_8Bits<float, int64_t>(false);
+  Test_GatherAxis0_8Bits<MLFloat16, int32_t>(false);
+  Test_GatherAxis0_8Bits<MLFloat16, int64_t>(true);
+}
+
+TEST(GatherBlockQuantizedOpTest, InvalidBits) {
+  OpTester test("GatherBlockQuantized", 1, kMSDomain);
+  test.AddAttribute<int64_t>("bits", 8);
+  test.AddInput<UInt4x2>("data", {2, 16}, ToType<UInt4x2>(std::vector<int>(32, 0)));
+  test.AddInput<int32_t>("indices", {1}, {0});
+  test.AddInput<float>("scales", {2, 1}, {1.0f, 1.0f});
+  test.AddOutput<float>("output", {1, 16}, std::vector<float>(16, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> eps;
+  eps.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "", {}, nullptr, &eps);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -277,6 +277,30 @@ TEST(ContribOpTest, TokenizerCharLevel_MixedCharsWithMarkersC) {
   }
 }
 
+TEST(ContribOpTest, TokenizerCharLevel_MixedAsciiRowsNoMarkersNC) {
+  // Char level tokenezation where some rows are ASCII only (longer than 8 bytes)
+  // and the others have multi-byte characters
+  // [N][C] dimensions
+  // Output [N][C][D]
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, {""}, 1);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{"abcdefghij", "Коñó", "a中b", "xyz"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(10));
+  std::vector<std::string> output{
+      "a", "b", "c", "d", "e", "f", "g", "h", "i", "j",
+      "К", "о", "ñ", "ó", padval, padval, padval, padval, padval, padval,
+      "a", "中", "b", padval, padval, padval, padval, padval, padval, padval,
+      "x", "y", "z", padval, padval, padval, padval, padval, padval, padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerCharLevel_EmptyOutputC) {
   // Special case where empty output is produced
   // For [C] we expect [C][0] output
@@ -716,6 +716,74 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// Check that the CPU element-wise and LayerNormalization kernels write their output over the input they are the
+// last consumer of, and that a broadcast input is not reused.
+TEST(AllocationPlannerTest, ElementwiseAndLayerNormRunInPlace) {
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+  TypeProto param_type;
+  param_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  param_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  for (const char* name : {"B", "scale", "bias"}) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(8);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name(name);
+    for (int i = 0; i < 8; ++i) tensor.add_float_data(0.5f);
+    graph.AddInitializedTensor(tensor);
+  }
+
+  auto& x = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& b = graph.GetOrCreateNodeArg("B", &param_type);
+  auto& scale = graph.GetOrCreateNodeArg("scale", &param_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &param_type);
+  auto& abs_out = graph.GetOrCreateNodeArg("abs_out", nullptr);
+  auto& add_out = graph.GetOrCreateNodeArg("add_out", nullptr);
+  auto& exp_out = graph.GetOrCreateNodeArg("exp_out", nullptr);
+  auto& norm_out = graph.GetOrCreateNodeArg("norm_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  graph.AddNode("abs", "Abs", "", {&x}, {&abs_out});
+  graph.AddNode("add", "Add", "", {&b, &abs_out}, {&add_out});
+  graph.AddNode("exp", "Exp", "", {&add_out}, {&exp_out});
+  graph.AddNode("norm", "LayerNormalization", "", {&exp_out, &scale, &bias}, {&norm_out});
+  graph.AddNode("mul", "Mul", "", {&norm_out, &b}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+  std::stringstream model_stream(serialized_model);
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSession sess{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.Load(model_stream));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& session_state = sess.GetSessionState();
+  const auto& ort_value_index_map = session_state.GetOrtValueNameIdxMap();
+  const auto& allocation_plan = session_state.GetExecutionPlan()->allocation_plan;
+
+  OrtValueIndex abs_out_index;
+  ASSERT_STATUS_OK(ort_value_index_map.GetIdx("abs_out", abs_out_index));
+  EXPECT_EQ(allocation_plan[abs_out_index].alloc_kind, AllocKind::kAllocate);
+
+  // Add reuses its second input as the first one is broadcast
+  for (const char* name : {"add_out", "exp_out", "norm_out"}) {
+    OrtValueIndex index;
+    ASSERT_STATUS_OK(ort_value_index_map.GetIdx(name, index));
+    EXPECT_EQ(allocation_plan[index].alloc_kind, AllocKind::kReuse) << name;
+    EXPECT_EQ(allocation_plan[index].reused_buffer, abs_out_index) << name;
+  }
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -10,6 +10,7 @@
 #include <future>
 #include <iterator>
 #include <thread>
+#include <filesystem>
 #include <fstream>
 #include <random>
 
@@ -29,6 +30,7 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/platform/env.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
@@ -49,6 +51,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/optimized_model_cache.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -57,6 +60,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -499,6 +503,120 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const std::string test_model = "testdata/transform/abs-id-max.onnx";
+  TemporaryDirectory cache_dir(ORT_TSTR("optimized_model_cache_test"));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                    ToUTF8String(cache_dir.Path()).c_str()));
+
+  auto get_cache_entries = [&cache_dir]() {
+    std::vector<std::filesystem::path> entries;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir.Path())) {
+      if (entry.path().extension() == ".onnx") {
+        entries.push_back(entry.path());
+      }
+    }
+    return entries;
+  };
+
+  auto count_identity_nodes = [&test_model](const SessionOptions& session_options) {
+    InferenceSessionWrapper session_object{session_options, GetEnvironment()};
+    EXPECT_STATUS_OK(session_object.Load(test_model));
+    EXPECT_STATUS_OK(session_object.Initialize());
+    return CountOpsInGraph(session_object.GetGraph())["Identity"];
+  };
+
+  // The first session optimizes the model and saves it.
+  ASSERT_EQ(count_identity_nodes(so), 0);
+  const auto entries = get_cache_entries();
+  ASSERT_EQ(entries.size(), 1u);
+
+  // The entry records its key.
+  constexpr const char* kEntryKeyMetadataName = "onnxruntime.optimized_model_cache.key";
+  std::shared_ptr<Model> cached_model;
+  ASSERT_STATUS_OK(Model::Load(entries[0].native(), cached_model, nullptr, DefaultLoggingManager().DefaultLogger()));
+  ASSERT_EQ(cached_model->MetaData().count(kEntryKeyMetadataName), 1u);
+  const std::string entry_key = cached_model->MetaData().at(kEntryKeyMetadataName);
+  EXPECT_NE(entry_key.find("execution_provider=CPUExecutionProvider"), std::string::npos);
+  EXPECT_NE(entry_key.find("nchwc_block_size=" + std::to_string(MlasNchwcGetBlockSize()) + "\n"), std::string::npos);
+  EXPECT_NE(entry_key.find("cpu_arch="), std::string::npos);
+
+  // Later sessions load the entry instead of optimizing the model. Replace the entry with the original model and
+  // the same key to see that the optimizations are skipped.
+  std::shared_ptr<Model> original_model;
+  ASSERT_STATUS_OK(Model::Load(ToPathString(test_model), original_model, nullptr,
+                               DefaultLoggingManager().DefaultLogger()));
+  original_model->SetMetaDataEntry(kEntryKeyMetadataName, entry_key);
+  ASSERT_STATUS_OK(Model::Save(*original_model, entries[0].native()));
+  ASSERT_GT(count_identity_nodes(so), 0);
+  ASSERT_EQ(get_cache_entries().size(), 1u);
+
+  // An entry with another key, e.g. from a hash collision, is replaced.
+  original_model->SetMetaDataEntry(kEntryKeyMetadataName, entry_key + "other=1\n");
+  ASSERT_STATUS_OK(Model::Save(*original_model, entries[0].native()));
+  ASSERT_EQ(count_identity_nodes(so), 0);
+  ASSERT_EQ(count_identity_nodes(so), 0);
+
+  // An entry that can not be loaded is replaced.
+  {
+    std::ofstream entry_file(entries[0], std::ios::binary | std::ios::trunc);
+    entry_file << "not a model";
+  }
+  ASSERT_EQ(count_identity_nodes(so), 0);
+  ASSERT_EQ(count_identity_nodes(so), 0);
+  ASSERT_EQ(get_cache_entries().size(), 1u);
+
+  // An entry saved on hardware with another NCHWc block size is not used. Save the original model as the entry for
+  // that key, the way a cache directory shared with another machine would hold it.
+  const std::string block_size_field = "nchwc_block_size=" + std::to_string(MlasNchwcGetBlockSize()) + "\n";
+  std::string other_key = entry_key;
+  other_key.replace(other_key.find(block_size_field), block_size_field.size(),
+                    "nchwc_block_size=" + std::to_string(MlasNchwcGetBlockSize() * 2) + "\n");
+  const auto other_path = optimized_model_cache::GetEntryPath(cache_dir.Path(), other_key);
+  ASSERT_NE(other_path, entries[0].native());
+  original_model->SetMetaDataEntry(kEntryKeyMetadataName, other_key);
+  ASSERT_STATUS_OK(Model::Save(*original_model, other_path));
+  ASSERT_EQ(count_identity_nodes(so), 0);
+  ASSERT_EQ(get_cache_entries().size(), 2u);
+
+  // Another optimization level is another entry.
+  so.graph_optimization_level = TransformerLevel::Level2;
+  ASSERT_EQ(count_identity_nodes(so), 0);
+  ASSERT_EQ(get_cache_entries().size(), 3u);
+}
+
+TEST(InferenceSessionTests, OptimizedModelCacheKeyHasHardwareFingerprint) {
+  const std::string hardware_fingerprint = optimized_model_cache::FingerprintHardware();
+  EXPECT_NE(hardware_fingerprint.find("cpu_arch="), std::string::npos);
+  EXPECT_NE(hardware_fingerprint.find("nchwc_block_size=" + std::to_string(MlasNchwcGetBlockSize())),
+            std::string::npos);
+
+  SessionOptions so;
+  const std::vector<std::string> execution_provider_types{kCpuExecutionProvider};
+  const std::string model_fingerprint = optimized_model_cache::FingerprintModelBytes("model", 5);
+  const auto get_entry_path = [&](const std::string& hardware) {
+    const auto key = optimized_model_cache::GetEntryKey(model_fingerprint, hardware, execution_provider_types,
+                                                        ProviderOptionsMap{}, so, InlinedHashSet<std::string>{});
+    return optimized_model_cache::GetEntryPath(ORT_TSTR("cache"), key);
+  };
+
+  // Every component of the hardware fingerprint selects another entry.
+  const auto entry_path = get_entry_path(hardware_fingerprint);
+  EXPECT_EQ(get_entry_path(hardware_fingerprint), entry_path);
+  size_t line_begin = 0;
+  while (line_begin < hardware_fingerprint.size()) {
+    const size_t line_end = hardware_fingerprint.find('\n', line_begin);
+    std::string changed = hardware_fingerprint;
+    changed.insert(line_end, "0");
+    EXPECT_NE(get_entry_path(changed), entry_path) << hardware_fingerprint.substr(line_begin, line_end - line_begin);
+    line_begin = line_end + 1;
+  }
+}
+
 TEST(InferenceSessionTests, RequestLoadCancellation) {
   {
     // Explicit cancel during load, small model is fine
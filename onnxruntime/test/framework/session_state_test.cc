@@ -21,6 +21,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/thread_utils.h"
 #include "gtest/gtest.h"
+#include "test/compare_ortvalue.h"
 #include "test/test_environment.h"
 #include "test/optimizer/graph_transform_test_builder.h"
 #include "test/util/include/test_environment.h"
@@ -657,6 +658,31 @@ static void CreateSimpleGraph(Graph& graph) {
   ASSERT_TRUE(status.IsOK());
 }
 
+// num_nodes PrePackingTest nodes that all use the same constant initializer
+static void CreateGraphWithSharedWeight(Graph& graph, int num_nodes) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& weight_arg = graph.GetOrCreateNodeArg("shared_weight", &type);
+  for (int i = 0; i < num_nodes; ++i) {
+    const std::string suffix = std::to_string(i);
+    auto& input_arg = graph.GetOrCreateNodeArg("node_" + suffix + "_input_0", &type);
+    auto& output_arg = graph.GetOrCreateNodeArg("node_" + suffix + "_output_0", &type);
+    graph.AddNode("node_" + suffix, "PrePackingTest", "node " + suffix, {&input_arg, &weight_arg}, {&output_arg});
+  }
+
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.add_float_data(1.0f);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("shared_weight");
+  graph.AddInitializedTensor(tensor);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK());
+}
+
 static const ONNX_NAMESPACE::GraphProto CreateSubgraph(bool then_branch) {
   Model model(then_branch ? "If_then" : "If_else", false, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
@@ -759,6 +785,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -766,6 +793,9 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   PrepackingTestParam test_param = GetParam();
 
   OrtThreadPoolParams to;
+  if (test_param.test_parallel_initialization) {
+    to.thread_pool_size = 4;
+  }
   auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
   ONNX_OPERATOR_SCHEMA(PrePackingTest)
       .SetDoc("Faking Node for PrePacking")
@@ -788,7 +818,10 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
               DefaultLoggingManager().DefaultLogger());
 
   // onnxruntime::Model model("graph_main", false, DefaultLoggingManager().DefaultLogger());
-  if (test_param.test_subgraph) {
+  constexpr int num_shared_weight_nodes = 8;
+  if (test_param.test_parallel_initialization) {
+    CreateGraphWithSharedWeight(model.MainGraph(), num_shared_weight_nodes);
+  } else if (test_param.test_subgraph) {
     CreateGraphWithSubgraph(model.MainGraph());
   } else {
     CreateSimpleGraph(model.MainGraph());
@@ -801,6 +834,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -832,6 +867,12 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
   // check prepacking
   ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+
+  if (test_param.test_parallel_initialization) {
+    // every node packs the shared weight, and it is released only after the last of them
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(),
+              size_t(test_param.test_prepacking ? num_shared_weight_nodes : 0));
+  }
 }
 
 class SessionStateTestSharedInitalizersWithPrePacking : public ::testing::Test {
@@ -1425,7 +1466,73 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, false, true},
+                                         PrepackingTestParam{false, true, true}));
+
+#if !defined(DISABLE_CONTRIB_OPS)
+// Pre-packs real MatMul and MatMulNBits kernels concurrently. MatMulNBits looks up its constant scales and zero
+// points from within PrePack(), which must not race with other nodes releasing their packed initializers.
+TEST(SessionStateTest, ParallelPrePackingOfMatMulKernels) {
+  constexpr int64_t M = 4, K = 64, N = 32, block_size = 32;
+  constexpr int64_t blocks_per_col = K / block_size;
+  constexpr int64_t blob_size = block_size / 2;
+  constexpr int num_nodes_per_op = 6;
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 17}, {kMSDomain, 1}};
+  Model model("parallel_prepacking", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  ModelTestBuilder builder(model.MainGraph());
+
+  auto* input = builder.MakeInput<float>({M, K}, -1.0f, 1.0f);
+  for (int i = 0; i < num_nodes_per_op; ++i) {
+    auto* weight = builder.MakeInitializer<float>({K, N}, -1.0f, 1.0f);
+    builder.AddNode("MatMul", {input, weight}, {builder.MakeOutput()});
+
+    auto* quantized_weight = builder.MakeInitializer<uint8_t>({N, blocks_per_col, blob_size}, 0, 255);
+    auto* scales = builder.MakeInitializer<float>({N * blocks_per_col}, 0.01f, 0.1f);
+    auto* zero_points = builder.MakeInitializer<uint8_t>({N * ((blocks_per_col + 1) / 2)}, 0, 255);
+    auto& matmul_nbits = builder.AddNode("MatMulNBits", {input, quantized_weight, scales, zero_points},
+                                         {builder.MakeOutput()}, kMSDomain);
+    matmul_nbits.AddAttribute("K", K);
+    matmul_nbits.AddAttribute("N", N);
+    matmul_nbits.AddAttribute("bits", int64_t{4});
+    matmul_nbits.AddAttribute("block_size", block_size);
+  }
+
+  builder.SetGraphOutputs();
+  ASSERT_STATUS_OK(model.MainGraph().Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  auto run = [&](bool parallel_initialization, std::vector<OrtValue>& fetches) {
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = 4;
+    so.config_options.configurations[kOrtSessionOptionsParallelInitialization] = parallel_initialization ? "1" : "0";
+
+    InferenceSessionWrapper session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+    ASSERT_STATUS_OK(session.Initialize());
+    ASSERT_GT(session.GetSessionState().GetNumberOfPrepacksCounter(), size_t{0});
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, builder.feeds_, builder.output_names_, &fetches));
+  };
+
+  std::vector<OrtValue> expected;
+  ASSERT_NO_FATAL_FAILURE(run(false, expected));
+
+  // repeat to give a race a chance to show up under a thread sanitizer
+  for (int iteration = 0; iteration < 5; ++iteration) {
+    std::vector<OrtValue> actual;
+    ASSERT_NO_FATAL_FAILURE(run(true, actual));
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      auto result = CompareOrtValue(actual[i], expected[i], 1e-5, 1e-5, false);
+      EXPECT_EQ(result.first, COMPARE_RESULT::SUCCESS) << result.second;
+    }
+  }
+}
+#endif  // !defined(DISABLE_CONTRIB_OPS)
 #endif
 
 }  // namespace test
@@ -2124,6 +2124,125 @@ TEST_F(GraphTest, SubgraphOutputIsOuterScopeValue) {
               ::testing::ContainsRegex("Subgraph output \\(.*\\) is an outer scope value being returned directly."));
 }
 
+TEST_F(GraphTest, GraphConstruction_MemoryAwareTopologicalSort) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  /*
+                      |
+               /             \
+        expand_a [1000]   expand_b [1000]
+              |               |
+        reduce_a [1]      reduce_b [1]
+               \             /
+                 merge (Merge)
+                      |
+  */
+
+  TypeProto tensor_small;
+  tensor_small.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  tensor_small.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto tensor_large;
+  tensor_large.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  tensor_large.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1000);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &tensor_small);
+  auto& expand_a_out = graph.GetOrCreateNodeArg("expand_a_out", &tensor_large);
+  auto& expand_b_out = graph.GetOrCreateNodeArg("expand_b_out", &tensor_large);
+  auto& reduce_a_out = graph.GetOrCreateNodeArg("reduce_a_out", &tensor_small);
+  auto& reduce_b_out = graph.GetOrCreateNodeArg("reduce_b_out", &tensor_small);
+  auto& output_arg = graph.GetOrCreateNodeArg("output", &tensor_small);
+
+  // the node indexes put both expansions first
+  graph.AddNode("expand_a", "Identity_Fake", "expand a", {&input_arg}, {&expand_a_out});
+  graph.AddNode("expand_b", "Identity_Fake", "expand b", {&input_arg}, {&expand_b_out});
+  graph.AddNode("reduce_a", "Identity_Fake", "reduce a", {&expand_a_out}, {&reduce_a_out});
+  graph.AddNode("reduce_b", "Identity_Fake", "reduce b", {&expand_b_out}, {&reduce_b_out});
+  graph.AddNode("merge", "Merge_Fake", "merge", {&reduce_a_out, &reduce_b_out}, {&output_arg});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  GraphViewer graph_viewer(graph);
+
+  // MEMORY_EFFICIENT order releases each large tensor before creating the next one.
+  // Training builds use the DEFAULT order for graphs without a YieldOp.
+  {
+    auto& order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT);
+#ifndef ENABLE_TRAINING
+    const std::vector<std::string> expected_order = {"expand_a", "reduce_a", "expand_b", "reduce_b", "merge"};
+    ASSERT_EQ(order.size(), expected_order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      auto node = graph.GetNode(order[i]);
+      EXPECT_EQ(node->Name(), expected_order[i]) << "MEMORY_EFFICIENT based execution order is wrong.";
+    }
+#else
+    EXPECT_EQ(order, graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::DEFAULT));
+#endif
+  }
+
+  std::vector<NodeIndex> memory_aware_order;
+  EXPECT_EQ(graph.MemoryAwareTopologicalSort(memory_aware_order), size_t{4008});
+  EXPECT_EQ(graph.EstimatePeakMemory(memory_aware_order), size_t{4008});
+
+  // PRIORITY_BASED order follows the node indexes and has both large tensors live at the same time
+  const auto& priority_order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::PRIORITY_BASED);
+  EXPECT_EQ(graph.EstimatePeakMemory(priority_order), size_t{8004});
+}
+
+TEST_F(GraphTest, GraphConstruction_MemoryAwareTopologicalSort_NetAllocationDecreases) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  /*
+                      |
+                 expand [1000]
+               /             \
+        reduce [1]        shrink [500]
+              |               |
+         grow [100]           |
+               \             /
+                 merge (Merge)
+                      |
+  */
+
+  auto make_type = [](int64_t size) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(size);
+    return type;
+  };
+  const TypeProto tensor_1 = make_type(1);
+  const TypeProto tensor_100 = make_type(100);
+  const TypeProto tensor_500 = make_type(500);
+  const TypeProto tensor_1000 = make_type(1000);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &tensor_1);
+  auto& expand_out = graph.GetOrCreateNodeArg("expand_out", &tensor_1000);
+  auto& reduce_out = graph.GetOrCreateNodeArg("reduce_out", &tensor_1);
+  auto& grow_out = graph.GetOrCreateNodeArg("grow_out", &tensor_100);
+  auto& shrink_out = graph.GetOrCreateNodeArg("shrink_out", &tensor_500);
+  auto& output_arg = graph.GetOrCreateNodeArg("output", &tensor_1);
+
+  graph.AddNode("expand", "Identity_Fake", "expand", {&input_arg}, {&expand_out});
+  graph.AddNode("reduce", "Identity_Fake", "reduce", {&expand_out}, {&reduce_out});
+  graph.AddNode("grow", "Identity_Fake", "grow", {&reduce_out}, {&grow_out});
+  graph.AddNode("shrink", "Identity_Fake", "shrink", {&expand_out}, {&shrink_out});
+  graph.AddNode("merge", "Merge_Fake", "merge", {&grow_out, &shrink_out}, {&output_arg});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  // Once reduce has run, shrink is the last consumer of expand_out and releases it, so it runs before grow even
+  // though it allocated more than grow when it became ready.
+  std::vector<NodeIndex> order;
+  graph.MemoryAwareTopologicalSort(order);
+  const std::vector<std::string> expected_order = {"expand", "reduce", "shrink", "grow", "merge"};
+  ASSERT_EQ(order.size(), expected_order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(graph.GetNode(order[i])->Name(), expected_order[i]);
+  }
+}
+
 #ifdef ENABLE_TRAINING
 
 TEST_F(GraphTest, GraphConstruction_MemoryEfficientTopologicalSort_Recompute) {
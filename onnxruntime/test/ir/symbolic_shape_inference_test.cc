@@ -0,0 +1,403 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+#include "core/graph/symbolic_shape_inference.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+TEST(SymbolicDimExprTest, CanonicalForm) {
+  EXPECT_EQ(SymbolicDimExpr::Parse("seq_len + past_len").ToString(), "past_len + seq_len");
+  EXPECT_TRUE(SymbolicDimExpr::Parse("seq_len+past_len") == SymbolicDimExpr::Parse("past_len + seq_len"));
+  EXPECT_EQ(SymbolicDimExpr::Parse("2*(a + b) - a").ToString(), "a + 2*b");
+  EXPECT_EQ(SymbolicDimExpr::Parse("b*a*b - 3").ToString(), "a*b*b - 3");
+
+  // anything that isn't an expression is an opaque symbol
+  EXPECT_EQ(SymbolicDimExpr::Parse("batch size").ToString(), "batch size");
+  EXPECT_TRUE(SymbolicDimExpr::Parse("unk__1") == SymbolicDimExpr::Symbol("unk__1"));
+
+  auto difference = SymbolicDimExpr::Parse("n + 1") - SymbolicDimExpr::Symbol("n");
+  ASSERT_TRUE(difference.IsConstant());
+  EXPECT_EQ(*difference.ConstantValue(), 1);
+}
+
+// Only dim_params in the canonical form written by the inference are read as expressions. Other names from a model
+// keep their exact name, so "batch-size" is not the difference of two symbols.
+TEST(SymbolicDimExprTest, ModelDimParamsAreOpaque) {
+  auto from_dim_param = [](const std::string& dim_param) {
+    TensorShapeProto_Dimension dim;
+    dim.set_dim_param(dim_param);
+    auto expr = SymbolicDimExpr::FromDimension(dim);
+    EXPECT_TRUE(expr.has_value());
+    return expr.value_or(SymbolicDimExpr());
+  };
+
+  EXPECT_TRUE(from_dim_param("batch-size") == SymbolicDimExpr::Symbol("batch-size"));
+  EXPECT_FALSE(from_dim_param("batch-size") == from_dim_param("batch - size"));
+  EXPECT_TRUE(from_dim_param("seq+1") == SymbolicDimExpr::Symbol("seq+1"));
+  EXPECT_TRUE(from_dim_param("b*a") == SymbolicDimExpr::Symbol("b*a"));
+
+  // an opaque symbol keeps its name in derived expressions
+  auto derived = from_dim_param("batch-size") + SymbolicDimExpr(1);
+  EXPECT_EQ(derived.ToString(), "batch-size + 1");
+
+  // canonical expressions are read back as the same expression
+  auto total = from_dim_param("past_len + seq_len");
+  EXPECT_TRUE(total - SymbolicDimExpr::Symbol("seq_len") == SymbolicDimExpr::Symbol("past_len"));
+  EXPECT_TRUE(from_dim_param("2*b*s - 1") == SymbolicDimExpr::Parse("2*b*s - 1"));
+}
+
+TEST(SymbolicDimExprTest, DivideExact) {
+  auto quotient = SymbolicDimExpr::Parse("2*b*s + 4*b").DivideExact(SymbolicDimExpr::Parse("2*b"));
+  ASSERT_TRUE(quotient.has_value());
+  EXPECT_EQ(quotient->ToString(), "s + 2");
+
+  auto total = SymbolicDimExpr::Parse("64*batch*(past_len + seq_len)");
+  quotient = total.DivideExact(SymbolicDimExpr::Parse("4*batch*(past_len + seq_len)"));
+  ASSERT_TRUE(quotient.has_value() && quotient->IsConstant());
+  EXPECT_EQ(*quotient->ConstantValue(), 16);
+
+  EXPECT_FALSE(SymbolicDimExpr::Parse("b*s").DivideExact(SymbolicDimExpr(2)).has_value());
+  EXPECT_FALSE(SymbolicDimExpr::Parse("b + s").DivideExact(SymbolicDimExpr::Symbol("b")).has_value());
+}
+
+TEST(SymbolicDimExprTest, OverflowInvalidatesExpression) {
+  const SymbolicDimExpr large(int64_t{1} << 40);
+  auto product = large * SymbolicDimExpr::Symbol("n") * large;
+  EXPECT_FALSE(product.IsValid());
+  EXPECT_FALSE(product == product);
+  EXPECT_FALSE((product - product).IsConstant());
+  EXPECT_FALSE(product.DivideExact(large).has_value());
+
+  auto sum = SymbolicDimExpr(std::numeric_limits<int64_t>::max()) + SymbolicDimExpr(1);
+  EXPECT_FALSE(sum.IsValid());
+  EXPECT_FALSE(sum.ConstantValue().has_value());
+
+  EXPECT_FALSE((SymbolicDimExpr(0) - SymbolicDimExpr(std::numeric_limits<int64_t>::min())).IsValid());
+  EXPECT_TRUE((large * SymbolicDimExpr::Symbol("n")).IsValid());
+}
+
+static void AddInt64Initializer(Graph& graph, const std::string& name, const std::vector<int64_t>& values,
+                                bool scalar = false) {
+  TensorProto initializer;
+  initializer.set_name(name);
+  initializer.set_data_type(TensorProto_DataType_INT64);
+  if (!scalar) {
+    initializer.add_dims(static_cast<int64_t>(values.size()));
+  }
+
+  for (int64_t value : values) {
+    initializer.add_int64_data(value);
+  }
+
+  graph.AddInitializedTensor(initializer);
+}
+
+static std::vector<std::string> GetDims(const NodeArg& node_arg) {
+  std::vector<std::string> dims;
+  const auto* shape = node_arg.Shape();
+  if (shape != nullptr) {
+    for (const auto& dim : shape->dim()) {
+      dims.push_back(utils::HasDimValue(dim) ? std::to_string(dim.dim_value()) : dim.dim_param());
+    }
+  }
+
+  return dims;
+}
+
+// the decoder pattern where the past KV cache is concatenated with the new tokens and the result is reshaped
+// using a shape computed in the graph. ONNX shape inference alone leaves the sequence dims unknown.
+TEST(SymbolicShapeInferenceTest, ResolvePropagatesDimExpressions) {
+  Model model("symbolic_shape_inference", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto past_type;
+  past_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  past_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  past_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("past_len");
+  past_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+  TypeProto current_type(past_type);
+  current_type.mutable_tensor_type()->mutable_shape()->mutable_dim(1)->set_dim_param("seq_len");
+
+  auto& past = graph.GetOrCreateNodeArg("past", &past_type);
+  auto& current = graph.GetOrCreateNodeArg("current", &current_type);
+  auto& present = graph.GetOrCreateNodeArg("present", nullptr);
+  auto& shape = graph.GetOrCreateNodeArg("shape", nullptr);
+  auto& leading_dims = graph.GetOrCreateNodeArg("leading_dims", nullptr);
+  auto& target_shape = graph.GetOrCreateNodeArg("target_shape", nullptr);
+  auto& reshaped = graph.GetOrCreateNodeArg("reshaped", nullptr);
+  auto& total_len = graph.GetOrCreateNodeArg("total_len", nullptr);
+  auto& positions = graph.GetOrCreateNodeArg("positions", nullptr);
+  auto& sliced = graph.GetOrCreateNodeArg("sliced", nullptr);
+
+  AddInt64Initializer(graph, "leading_indices", {0, 1});
+  AddInt64Initializer(graph, "head_shape", {4, -1});
+  AddInt64Initializer(graph, "len_index", {1}, true);
+  AddInt64Initializer(graph, "zero", {0}, true);
+  AddInt64Initializer(graph, "one", {1}, true);
+  AddInt64Initializer(graph, "slice_starts", {1});
+  AddInt64Initializer(graph, "slice_ends", {std::numeric_limits<int64_t>::max()});
+  AddInt64Initializer(graph, "slice_axes", {1});
+
+  auto& concat = graph.AddNode("concat", "Concat", "", {&past, &current}, {&present});
+  concat.AddAttribute("axis", int64_t{1});
+  graph.AddNode("shape", "Shape", "", {&present}, {&shape});
+  graph.AddNode("gather_leading", "Gather", "", {&shape, graph.GetNodeArg("leading_indices")}, {&leading_dims});
+  auto& concat_shape = graph.AddNode("concat_shape", "Concat", "",
+                                     {&leading_dims, graph.GetNodeArg("head_shape")}, {&target_shape});
+  concat_shape.AddAttribute("axis", int64_t{0});
+  graph.AddNode("reshape", "Reshape", "", {&present, &target_shape}, {&reshaped});
+  graph.AddNode("gather_len", "Gather", "", {&shape, graph.GetNodeArg("len_index")}, {&total_len});
+  graph.AddNode("range", "Range", "", {graph.GetNodeArg("zero"), &total_len, graph.GetNodeArg("one")}, {&positions});
+  graph.AddNode("slice", "Slice", "",
+                {&present, graph.GetNodeArg("slice_starts"), graph.GetNodeArg("slice_ends"),
+                 graph.GetNodeArg("slice_axes")},
+                {&sliced});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  EXPECT_EQ(GetDims(*graph.GetNodeArg("present")), (std::vector<std::string>{"batch", "past_len + seq_len", "64"}));
+  EXPECT_EQ(GetDims(*graph.GetNodeArg("reshaped")),
+            (std::vector<std::string>{"batch", "past_len + seq_len", "4", "16"}));
+  EXPECT_EQ(GetDims(*graph.GetNodeArg("positions")), (std::vector<std::string>{"past_len + seq_len"}));
+  EXPECT_EQ(GetDims(*graph.GetNodeArg("sliced")),
+            (std::vector<std::string>{"batch", "past_len + seq_len - 1", "64"}));
+}
+
+// Shape with start/end, Mul and Div of the values, and their use as the shape input of ConstantOfShape and Expand.
+TEST(SymbolicShapeInferenceTest, ResolvePropagatesShapeArithmetic) {
+  Model model("symbolic_shape_inference", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+  TypeProto bias_type;
+  bias_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  bias_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  bias_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  auto& input = graph.GetOrCreateNodeArg("input", &input_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &bias_type);
+  auto& batch_shape = graph.GetOrCreateNodeArg("batch_shape", nullptr);
+  auto& seq_shape = graph.GetOrCreateNodeArg("seq_shape", nullptr);
+  auto& seq_times_4 = graph.GetOrCreateNodeArg("seq_times_4", nullptr);
+  auto& seq_times_2 = graph.GetOrCreateNodeArg("seq_times_2", nullptr);
+  auto& fill_shape = graph.GetOrCreateNodeArg("fill_shape", nullptr);
+  auto& expand_shape = graph.GetOrCreateNodeArg("expand_shape", nullptr);
+  auto& filled = graph.GetOrCreateNodeArg("filled", nullptr);
+  auto& expanded = graph.GetOrCreateNodeArg("expanded", nullptr);
+
+  AddInt64Initializer(graph, "four", {4});
+  AddInt64Initializer(graph, "two", {2});
+  AddInt64Initializer(graph, "one", {1});
+
+  graph.AddNode("batch_shape", "Shape", "", {&input}, {&batch_shape}).AddAttribute("end", int64_t{1});
+  auto& seq_shape_node = graph.AddNode("seq_shape", "Shape", "", {&input}, {&seq_shape});
+  seq_shape_node.AddAttribute("start", int64_t{1});
+  seq_shape_node.AddAttribute("end", int64_t{-1});
+  graph.AddNode("mul", "Mul", "", {&seq_shape, graph.GetNodeArg("four")}, {&seq_times_4});
+  graph.AddNode("div", "Div", "", {&seq_times_4, graph.GetNodeArg("two")}, {&seq_times_2});
+  graph.AddNode("fill_shape", "Concat", "", {&batch_shape, &seq_times_2}, {&fill_shape})
+      .AddAttribute("axis", int64_t{0});
+  graph.AddNode("fill", "ConstantOfShape", "", {&fill_shape}, {&filled});
+  graph.AddNode("expand_shape", "Concat", "", {&batch_shape, &seq_times_2, graph.GetNodeArg("one")}, {&expand_shape})
+      .AddAttribute("axis", int64_t{0});
+  graph.AddNode("expand", "Expand", "", {&bias, &expand_shape}, {&expanded});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  EXPECT_EQ(GetDims(*graph.GetNodeArg("filled")), (std::vector<std::string>{"batch", "2*seq"}));
+  EXPECT_EQ(GetDims(*graph.GetNodeArg("expanded")), (std::vector<std::string>{"batch", "2*seq", "8"}));
+}
+
+static std::vector<TypeProto> UnknownFloatTensorOutput() {
+  TypeProto output_type;
+  output_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  return {output_type};
+}
+
+// A symbolic dim can not be clamped, so a Slice length where the dim cancels out is only right if the dim is
+// large enough. Such lengths are left unknown rather than set to a constant that may be wrong or negative.
+TEST(SymbolicShapeInferenceTest, RefineSliceOnlySetsSafeLengths) {
+  Model model("symbolic_shape_inference", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("n");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+  auto& input = graph.GetOrCreateNodeArg("input", &input_type);
+
+  struct SliceCase {
+    int64_t start;
+    int64_t end;
+    int64_t axis;
+  };
+  const std::vector<SliceCase> cases = {{-5, -1, 0}, {-1, -3, 0}, {0, -1, 0}, {-4, -1, 1}, {-1, -3, 1}};
+  std::vector<Node*> slice_nodes;
+  for (size_t i = 0; i < cases.size(); ++i) {
+    const std::string suffix = std::to_string(i);
+    AddInt64Initializer(graph, "starts" + suffix, {cases[i].start});
+    AddInt64Initializer(graph, "ends" + suffix, {cases[i].end});
+    AddInt64Initializer(graph, "axes" + suffix, {cases[i].axis});
+    auto& output = graph.GetOrCreateNodeArg("sliced" + suffix, nullptr);
+    slice_nodes.push_back(&graph.AddNode("slice" + suffix, "Slice", "",
+                                         {&input, graph.GetNodeArg("starts" + suffix),
+                                          graph.GetNodeArg("ends" + suffix), graph.GetNodeArg("axes" + suffix)},
+                                         {&output}));
+  }
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // refine from an unknown output shape so the result does not depend on what ONNX inferred
+  const symbolic_shape_inference::SymbolicDataMap no_symbolic_data;
+  auto refine = [&](size_t index) {
+    auto output_types = UnknownFloatTensorOutput();
+    symbolic_shape_inference::RefineOutputShapes(*slice_nodes[index], graph, no_symbolic_data, output_types);
+    std::vector<std::string> dims;
+    for (const auto& dim : output_types[0].tensor_type().shape().dim()) {
+      dims.push_back(utils::HasDimValue(dim) ? std::to_string(dim.dim_value()) : dim.dim_param());
+    }
+
+    return dims;
+  };
+
+  EXPECT_EQ(refine(0), (std::vector<std::string>{"", ""}));  // 4 only if n >= 5
+  EXPECT_EQ(refine(1), (std::vector<std::string>{"", ""}));  // never -2
+  EXPECT_EQ(refine(2), (std::vector<std::string>{"n - 1", ""}));
+  EXPECT_EQ(refine(3), (std::vector<std::string>{"", "3"}));  // clamped like Slice for a known dim
+  EXPECT_EQ(refine(4), (std::vector<std::string>{"", ""}));   // empty
+}
+
+// Range yields no elements when the limit is below the start, even if both are only known through the symbolic
+// values of other tensors.
+TEST(SymbolicShapeInferenceTest, RefineRangeClampsLength) {
+  Model model("symbolic_shape_inference", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto scalar_type;
+  scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  scalar_type.mutable_tensor_type()->mutable_shape();
+  auto& start = graph.GetOrCreateNodeArg("start", &scalar_type);
+  auto& limit = graph.GetOrCreateNodeArg("limit", &scalar_type);
+  auto& positions = graph.GetOrCreateNodeArg("positions", nullptr);
+  AddInt64Initializer(graph, "one", {1}, true);
+  auto& range = graph.AddNode("range", "Range", "", {&start, &limit, graph.GetNodeArg("one")}, {&positions});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto refine = [&](int64_t start_value, int64_t limit_value) {
+    symbolic_shape_inference::SymbolicDataMap symbolic_data;
+    symbolic_data["start"].add_dim()->set_dim_value(start_value);
+    symbolic_data["limit"].add_dim()->set_dim_value(limit_value);
+    TypeProto output_type;
+    output_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    std::vector<TypeProto> output_types{output_type};
+    symbolic_shape_inference::RefineOutputShapes(range, graph, symbolic_data, output_types);
+    const auto& shape = output_types[0].tensor_type().shape();
+    EXPECT_EQ(shape.dim_size(), 1);
+    return shape.dim_size() == 1 && utils::HasDimValue(shape.dim(0)) ? shape.dim(0).dim_value() : int64_t{-1};
+  };
+
+  EXPECT_EQ(refine(2, 7), 5);
+  EXPECT_EQ(refine(7, 2), 0);
+  EXPECT_EQ(refine(3, 3), 0);
+}
+
+TEST(SymbolicShapeInferenceTest, InferredDimsAreNotOverwritten) {
+  Model model("symbolic_shape_inference", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto past_type;
+  past_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  past_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("past_len");
+  past_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto current_type(past_type);
+  current_type.mutable_tensor_type()->mutable_shape()->mutable_dim(0)->set_dim_param("seq_len");
+
+  auto& past = graph.GetOrCreateNodeArg("past", &past_type);
+  auto& current = graph.GetOrCreateNodeArg("current", &current_type);
+  auto& present = graph.GetOrCreateNodeArg("present", nullptr);
+  auto& concat = graph.AddNode("concat", "Concat", "", {&past, &current}, {&present});
+  concat.AddAttribute("axis", int64_t{0});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const symbolic_shape_inference::SymbolicDataMap no_symbolic_data;
+  auto output_types = UnknownFloatTensorOutput();
+  auto* shape = output_types[0].mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_param("total_len");
+  shape->add_dim();
+  symbolic_shape_inference::RefineOutputShapes(concat, graph, no_symbolic_data, output_types);
+  EXPECT_EQ(shape->dim(0).dim_param(), "total_len");
+  EXPECT_FALSE(utils::HasDimValue(shape->dim(1)));
+
+  shape->mutable_dim(0)->set_dim_value(7);
+  symbolic_shape_inference::RefineOutputShapes(concat, graph, no_symbolic_data, output_types);
+  EXPECT_EQ(shape->dim(0).dim_value(), 7);
+
+  shape->mutable_dim(0)->Clear();
+  symbolic_shape_inference::RefineOutputShapes(concat, graph, no_symbolic_data, output_types);
+  EXPECT_EQ(shape->dim(0).dim_param(), "past_len + seq_len");
+}
+
+// values are stored as a flat list, so a rank 2 result such as an Unsqueeze of a shape is not tracked
+TEST(SymbolicShapeInferenceTest, OnlyRankOneDataIsTracked) {
+  Model model("symbolic_shape_inference", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 17}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+
+  auto& input = graph.GetOrCreateNodeArg("input", &input_type);
+  auto& shape = graph.GetOrCreateNodeArg("shape", nullptr);
+  auto& unsqueezed = graph.GetOrCreateNodeArg("unsqueezed", nullptr);
+  AddInt64Initializer(graph, "axes", {0});
+  auto& shape_node = graph.AddNode("shape", "Shape", "", {&input}, {&shape});
+  auto& unsqueeze_node = graph.AddNode("unsqueeze", "Unsqueeze", "", {&shape, graph.GetNodeArg("axes")},
+                                       {&unsqueezed});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto int64_output = [](int rank) {
+    TypeProto output_type;
+    output_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    auto* output_shape = output_type.mutable_tensor_type()->mutable_shape();
+    for (int i = 0; i < rank; ++i) {
+      output_shape->add_dim();
+    }
+
+    return std::vector<TypeProto>{output_type};
+  };
+
+  symbolic_shape_inference::SymbolicDataMap symbolic_data;
+  symbolic_shape_inference::PropagateSymbolicData(shape_node, graph, int64_output(1), symbolic_data);
+  ASSERT_EQ(symbolic_data.count("shape"), 1u);
+  EXPECT_EQ(symbolic_data["shape"].dim(1).dim_param(), "seq");
+
+  symbolic_shape_inference::PropagateSymbolicData(unsqueeze_node, graph, int64_output(2), symbolic_data);
+  EXPECT_EQ(symbolic_data.count("unsqueezed"), 0u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
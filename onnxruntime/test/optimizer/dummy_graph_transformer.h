@@ -26,6 +26,63 @@ class DummyGraphTransformer : public GraphTransformer {
   }
 };
 
+// Graph transformer that does nothing but count how many times it was applied. It declares the given op types as
+// its targets so the transformer manager may skip it when nodes of those types have not changed.
+class CountingGraphTransformer : public GraphTransformer {
+ public:
+  CountingGraphTransformer(const std::string& name, InlinedVector<std::string_view> target_op_types) noexcept
+      : GraphTransformer(name), target_op_types_(std::move(target_op_types)) {}
+
+  int ApplyCount() const {
+    return apply_count_;
+  }
+
+  InlinedVector<std::string_view> TargetOpTypes() const override {
+    return target_op_types_;
+  }
+
+ private:
+  InlinedVector<std::string_view> target_op_types_;
+  mutable int apply_count_{0};
+
+  Status ApplyImpl(Graph& /*graph*/, bool& /*modified*/, int graph_level, const logging::Logger&) const override {
+    if (graph_level == 0) {
+      ++apply_count_;
+    }
+    return Status::OK();
+  }
+};
+
+// Graph transformer that sets a float attribute of every node of the given op type to the given value. Only the
+// attribute value changes, the nodes and their connections stay the same. It has no target op types.
+class SetFloatAttributeGraphTransformer : public GraphTransformer {
+ public:
+  SetFloatAttributeGraphTransformer(const std::string& name, std::string op_type, std::string attr_name,
+                                    float value) noexcept
+      : GraphTransformer(name), op_type_(std::move(op_type)), attr_name_(std::move(attr_name)), value_(value) {}
+
+ private:
+  std::string op_type_;
+  std::string attr_name_;
+  float value_;
+
+  Status ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() != op_type_) {
+        continue;
+      }
+
+      const auto& attributes = node.GetAttributes();
+      auto attr = attributes.find(attr_name_);
+      if (attr == attributes.end() || attr->second.f() != value_) {
+        node.AddAttribute(attr_name_, value_);
+        modified = true;
+      }
+    }
+    return Status::OK();
+  }
+};
+
 // Dummy graph transformer that does nothing, but just sets the modified value
 // This is currently used to test custom transformer selection feature
 class DummyRewriteRule : public RewriteRule {
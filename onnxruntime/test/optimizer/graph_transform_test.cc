@@ -38,6 +38,7 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gather_fusion.h"
@@ -81,6 +82,7 @@
 #include "test/common/tensor_op_test_utils.h"
 #include "test/compare_ortvalue.h"
 #include "test/framework/test_utils.h"
+#include "test/optimizer/dummy_graph_transformer.h"
 #include "test/optimizer/graph_transform_test_builder.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/providers/provider_test_utils.h"
@@ -119,6 +121,71 @@ TEST_F(GraphTransformationTests, IdentityElimination) {
   ASSERT_TRUE(op_to_count["Identity"] == 0);
 }
 
+// After the first step, transformers with target op types only re-run if nodes of those types changed.
+TEST_F(GraphTransformationTests, TransformerManagerSkipsUnaffectedTransformers) {
+  constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id-max.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+
+  auto rule_transformer_L1 = std::make_unique<RuleBasedGraphTransformer>("RuleTransformer1");
+  ASSERT_STATUS_OK(rule_transformer_L1->Register(std::make_unique<EliminateIdentity>()));
+  auto unaffected = std::make_unique<CountingGraphTransformer>("Unaffected", InlinedVector<std::string_view>{"Conv"});
+  auto affected = std::make_unique<CountingGraphTransformer>("Affected", InlinedVector<std::string_view>{"Max"});
+  auto any_op = std::make_unique<CountingGraphTransformer>("AnyOp", InlinedVector<std::string_view>{});
+  const auto* unaffected_ptr = unaffected.get();
+  const auto* affected_ptr = affected.get();
+  const auto* any_op_ptr = any_op.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(unaffected), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(affected), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(any_op), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(rule_transformer_L1), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // The rule based transformer runs last in the first step. Removing the Identity rewires the Max node, so only the
+  // transformers that can match Max run a second time, and the rule based transformer has no Identity left to match.
+  ASSERT_EQ(CountOpsInGraph(graph)["Identity"], 0);
+  EXPECT_EQ(unaffected_ptr->ApplyCount(), 1);
+  EXPECT_EQ(affected_ptr->ApplyCount(), 2);
+  EXPECT_EQ(any_op_ptr->ApplyCount(), 2);
+}
+
+// A change of an attribute value alone makes the transformers that target the op type of the node run again.
+TEST_F(GraphTransformationTests, TransformerManagerRerunsOnAttributeChange) {
+  Model model("TransformerManagerRerunsOnAttributeChange", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 14}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& output = graph.GetOrCreateNodeArg("output", &tensor_type);
+  auto& leaky_relu = graph.AddNode("leaky_relu", "LeakyRelu", "LeakyRelu", {&input}, {&output});
+  leaky_relu.AddAttribute("alpha", 0.01f);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto unaffected = std::make_unique<CountingGraphTransformer>("Unaffected", InlinedVector<std::string_view>{"Conv"});
+  auto affected = std::make_unique<CountingGraphTransformer>("Affected",
+                                                             InlinedVector<std::string_view>{"LeakyRelu"});
+  const auto* unaffected_ptr = unaffected.get();
+  const auto* affected_ptr = affected.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(unaffected), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(affected), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<SetFloatAttributeGraphTransformer>("SetAlpha", "LeakyRelu", "alpha", 0.2f),
+      TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  EXPECT_EQ(leaky_relu.GetAttributes().at("alpha").f(), 0.2f);
+  EXPECT_EQ(unaffected_ptr->ApplyCount(), 1);
+  EXPECT_EQ(affected_ptr->ApplyCount(), 2);
+}
+
 TEST_F(GraphTransformationTests, IdentityEliminationWithGraphOutput) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id.onnx";
   std::shared_ptr<Model> model;
@@ -1027,6 +1094,61 @@ TEST_F(GraphTransformationTests, ConstantFoldingAShapeNodeDeepInTheGraph) {
   ASSERT_TRUE(op_to_count.size() == 0U);
 }
 
+// Shape -> Gather of static dims is folded even when other dims are symbolic, and the shape arithmetic consuming it
+// is folded with it. Gathering a symbolic dim is left alone.
+TEST_F(GraphTransformationTests, ConstantFoldingGatherOfStaticDimsFromDynamicShape) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeSymbolicInput<float>({"batch", 4, 8});
+    auto* static_indices = builder.MakeInitializer<int64_t>({2}, {-2, -1});
+    auto* dynamic_index = builder.MakeScalarInitializer<int64_t>(0);
+    auto* minus_one = builder.MakeInitializer<int64_t>({1}, {-1});
+    auto* shape_out = builder.MakeIntermediate();
+    auto* static_dims_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* reshape_out = builder.MakeOutput();
+    auto* batch_out = builder.MakeOutput();
+
+    builder.AddNode("Shape", {input_arg}, {shape_out});
+    builder.AddNode("Gather", {shape_out, static_indices}, {static_dims_out});
+    builder.AddNode("Concat", {minus_one, static_dims_out}, {concat_out}).AddAttribute("axis", int64_t(0));
+    builder.AddNode("Reshape", {input_arg, concat_out}, {reshape_out});
+    builder.AddNode("Gather", {shape_out, dynamic_index}, {batch_out});
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 2);
+    TEST_RETURN_IF_NOT(op_count_map["Concat"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Shape"] == 1);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+    TEST_RETURN_IF_NOT(op_count_map["Concat"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Reshape"] == 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Reshape") {
+        const auto* shape_tensor = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+        TEST_RETURN_IF_NOT(shape_tensor != nullptr);
+        Initializer shape{*shape_tensor, graph.ModelPath()};
+        TEST_RETURN_IF_NOT(std::vector<int64_t>(shape.data<int64_t>(), shape.data<int64_t>() + shape.size()) ==
+                           std::vector<int64_t>({-1, 4, 8}));
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  const ConfigOptions empty_config_options;
+  std::unique_ptr<GraphTransformer> transformer =
+      std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/, empty_config_options);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::move(transformer), TransformerLevel::Level1,
+                                        1, pre_graph_checker, post_graph_checker));
+}
+
 // Test we don't fail when constant folding hits a string initializer
 TEST_F(GraphTransformationTests, ConstantFoldingStringInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "gh_issue_17392.onnx";
@@ -8086,6 +8208,294 @@ TEST_F(GraphTransformationTests, GatherToSliceFusion) {
 
 #if !defined(DISABLE_CONTRIB_OPS)
 
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_WeightedReduceSum) {
+  // Opset 13 ReduceSum takes its axes as an input.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 3}, {0, 5, 15, -1, 3, 3});
+    auto* weights_arg = builder.MakeInput<float>({2, 3, 1}, -2.f, 2.f);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("Mul", {gather_out, weights_arg}, {mul_out});
+    builder.AddNode("ReduceSum", {mul_out, axes_arg}, {output_arg})
+        .AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["ReduceSum"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    1e-5, 1e-5);
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_ReduceMean) {
+  // Opset 12 ReduceMean takes its axes as an attribute, here relative to the end of the gathered tensor.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int32_t>({4}, {1, 7, 7, 2});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    auto& reduce_node = builder.AddNode("ReduceMean", {gather_out}, {output_arg});
+    reduce_node.AddAttribute("axes", std::vector<int64_t>{-2});
+    reduce_node.AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["ReduceMean"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 12,
+                    1e-5, 1e-5);
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_KeepDimsNotFused) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 2}, {0, 1, 2, 3});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("ReduceSum", {gather_out}, {output_arg})
+        .AddAttribute("axes", std::vector<int64_t>{1});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 0);
+    EXPECT_EQ(op_to_count["Gather"], 1);
+    EXPECT_EQ(op_to_count["ReduceSum"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 12);
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_SquaredRowsNotFused) {
+  // With an embedding dim of 1 the gathered tensor has the per sample weight shape, but Mul(x, x) squares the rows.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({16, 1}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 3}, {0, 5, 15, 1, 3, 3});
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("Mul", {gather_out, gather_out}, {mul_out});
+    builder.AddNode("ReduceSum", {mul_out, axes_arg}, {output_arg})
+        .AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 0);
+    EXPECT_EQ(op_to_count["Gather"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 1);
+    EXPECT_EQ(op_to_count["ReduceSum"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13);
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_ReduceMeanOfPossiblyEmptyBagsNotFused) {
+  // ReduceMean of an empty bag is NaN, where EmbeddingBag would return 0. A sum is fine either way.
+  auto build_test_case = [&](ModelTestBuilder& builder, const char* reduce_op) {
+    auto* table_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeSymbolicInput<int64_t>({"batch", "bag_size"});
+    auto* gather_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    auto& reduce_node = builder.AddNode(reduce_op, {gather_out}, {output_arg});
+    reduce_node.AddAttribute("axes", std::vector<int64_t>{1});
+    reduce_node.AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_fused = [&](const char* reduce_op, int expected_count) {
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == expected_count);
+      TEST_RETURN_IF_NOT(op_to_count[reduce_op] == 1 - expected_count);
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(
+        [&](ModelTestBuilder& builder) { build_test_case(builder, reduce_op); }, 12, *logger_,
+        std::make_unique<EmbeddingBagFusion>(), TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  };
+
+  check_fused("ReduceMean", 0);
+  check_fused("ReduceSum", 1);
+}
+
+static void BuildEncoderFeedForward(ModelTestBuilder& builder, bool residual_is_input) {
+  auto* input_arg = builder.MakeInput<float>({2, 3, 8}, -1.f, 1.f);
+  auto* other_arg = builder.MakeInput<float>({2, 3, 8}, -1.f, 1.f);
+  auto* weight1_arg = builder.MakeInitializer<float>({8, 32}, -0.5f, 0.5f);
+  auto* bias1_arg = builder.MakeInitializer<float>({32}, -0.5f, 0.5f);
+  auto* weight2_arg = builder.MakeInitializer<float>({32, 8}, -0.5f, 0.5f);
+  auto* gamma_arg = builder.MakeInitializer<float>({8}, 0.5f, 1.5f);
+  auto* beta_arg = builder.MakeInitializer<float>({8}, -0.5f, 0.5f);
+  auto* bias2_arg = builder.MakeInitializer<float>({8}, -0.5f, 0.5f);
+  auto* matmul1_out = builder.MakeIntermediate();
+  auto* gelu_out = builder.MakeIntermediate();
+  auto* matmul2_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+
+  builder.AddNode("MatMul", {input_arg, weight1_arg}, {matmul1_out});
+  builder.AddNode("BiasGelu", {matmul1_out, bias1_arg}, {gelu_out}, kMSDomain);
+  builder.AddNode("MatMul", {gelu_out, weight2_arg}, {matmul2_out});
+  builder.AddNode("SkipLayerNormalization",
+                  {matmul2_out, residual_is_input ? input_arg : other_arg, gamma_arg, beta_arg, bias2_arg},
+                  {output_arg}, kMSDomain)
+      .AddAttribute("epsilon", 1e-5f);
+}
+
+static void EnableEncoderFeedForwardFusion(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(
+      session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableEncoderFeedForwardFusion, "1"));
+}
+
+TEST_F(GraphTransformationTests, EncoderFeedForwardFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) { BuildEncoderFeedForward(builder, true); };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EncoderFeedForward"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 0);
+    EXPECT_EQ(op_to_count["com.microsoft.BiasGelu"], 0);
+    EXPECT_EQ(op_to_count["com.microsoft.SkipLayerNormalization"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    1e-4, 1e-4, nullptr, EnableEncoderFeedForwardFusion);
+}
+
+// The fusion is off unless it is enabled in the session options.
+TEST_F(GraphTransformationTests, EncoderFeedForwardFusion_DisabledByDefault) {
+  auto build_test_case = [](ModelTestBuilder& builder) { BuildEncoderFeedForward(builder, true); };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EncoderFeedForward"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    1e-4, 1e-4);
+}
+
+TEST_F(GraphTransformationTests, EncoderFeedForwardFusion_DifferentResidualNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) { BuildEncoderFeedForward(builder, false); };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EncoderFeedForward"], 0);
+    EXPECT_EQ(op_to_count["MatMul"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.SkipLayerNormalization"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    0.0, 0.0, nullptr, EnableEncoderFeedForwardFusion);
+}
+
+static void EnableFusedElementwise(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableFusedElementwise, "1"));
+}
+
+TEST_F(GraphTransformationTests, FusedElementwiseFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({2, 3, 8}, -1.f, 1.f);
+    auto* y_arg = builder.MakeInput<float>({2, 3, 8}, -1.f, 1.f);
+    auto* z_arg = builder.MakeInput<float>({1, 3, 1}, 1.f, 2.f);
+    auto* condition_arg = builder.MakeInputBool({2, 3, 8});
+    auto* bias_arg = builder.MakeInitializer<float>({8}, -0.5f, 0.5f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, bias_arg}, {add_out});
+    builder.AddNode("Mul", {add_out, y_arg}, {mul_out});
+    builder.AddNode("Tanh", {mul_out}, {tanh_out});
+    builder.AddNode("Div", {tanh_out, z_arg}, {div_out});
+    builder.AddNode("Sub", {div_out, x_arg}, {sub_out});
+    builder.AddNode("Where", {condition_arg, sub_out, x_arg}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Where"], 0);
+
+    for (const auto& node : session.GetGraph().Nodes()) {
+      if (node.OpType() == "FusedElementwise") {
+        // x, bias, y, z and condition, with x used by three of the nodes
+        EXPECT_EQ(node.InputDefs().size(), 5u);
+      }
+    }
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    1e-5, 1e-5, nullptr, EnableFusedElementwise);
+}
+
+// The output of Add is used twice, and the output of Sqrt has to be broadcast, so neither is fused.
+TEST_F(GraphTransformationTests, FusedElementwiseFusion_SharedAndBroadcastOutputsNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({2, 8}, -1.f, 1.f);
+    auto* y_arg = builder.MakeInput<float>({2, 8}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeInput<float>({8}, 1.f, 2.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* erf_out = builder.MakeIntermediate();
+    auto* sqrt_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, y_arg}, {add_out});
+    builder.AddNode("Tanh", {add_out}, {tanh_out});
+    builder.AddNode("Erf", {add_out}, {erf_out});
+    builder.AddNode("Sqrt", {scale_arg}, {sqrt_out});
+    builder.AddNode("Mul", {tanh_out, erf_out}, {mul_out});
+    builder.AddNode("Div", {mul_out, sqrt_out}, {output_arg});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Sqrt"], 1);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Erf"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    1e-5, 1e-5, nullptr, EnableFusedElementwise);
+}
+
 TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   struct TestOptions {
     bool bias_is_first_add_input{false};
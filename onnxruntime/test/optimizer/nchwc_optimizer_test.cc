@@ -6,6 +6,7 @@
 #include "core/mlas/inc/mlas.h"
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/tensorprotoutils.h"
 #include "test/compare_ortvalue.h"
 #include "test/test_environment.h"
@@ -168,7 +169,8 @@ struct NchwcTestHelper {
 
 void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& build_test_case,
                           const std::function<void(InferenceSessionWrapper& session)>& check_nchwc_graph,
-                          int opset_version = 13) {
+                          int opset_version = 13,
+                          const std::function<void(SessionOptions& session_options)>& configure_session = nullptr) {
   // Ignore the test if NCHWc is not supported by the platform.
   if (MlasNchwcGetBlockSize() <= 1) {
     return;
@@ -191,6 +193,9 @@ void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& bu
     SessionOptions session_options;
     session_options.graph_optimization_level = level;
     session_options.session_logid = "NchwcOptimizerTests";
+    if (configure_session) {
+      configure_session(session_options);
+    }
     InferenceSessionWrapper session{session_options, GetEnvironment()};
     ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
     ASSERT_STATUS_OK(session.Initialize());
@@ -1402,6 +1407,44 @@ TEST(NchwcOptimizerTests, MaxPoolTypeCheck) {
   NchwcOptimizerTester(build_test_case, check_nchwc_graph, 12);
 }
 
+TEST(NchwcOptimizerTests, LayoutCostModel) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, int64_t kernel_size, bool expect_nchwc) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>(input_shape);
+      auto* conv1_output_arg = helper.MakeIntermediate();
+      auto* relu_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      const int64_t channels = input_shape[1];
+      const int64_t pad = kernel_size / 2;
+      auto& conv1_node = helper.AddConvNode(input_arg, conv1_output_arg, {channels, channels, kernel_size, kernel_size});
+      conv1_node.AddAttribute("pads", std::vector<int64_t>{pad, pad, pad, pad});
+      helper.AddNode("Relu", {conv1_output_arg}, {relu_output_arg});
+      auto& conv2_node = helper.AddConvNode(relu_output_arg, output_arg, {channels, channels, kernel_size, kernel_size});
+      conv2_node.AddAttribute("pads", std::vector<int64_t>{pad, pad, pad, pad});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], expect_nchwc ? 2 : 0);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], expect_nchwc ? 1 : 0);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], expect_nchwc ? 1 : 0);
+    };
+
+    auto configure_session = [](SessionOptions& session_options) {
+      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsNchwcLayoutCostModel, "1"));
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph, 13, configure_session);
+  };
+
+  // The pointwise convolutions on a small image do not cover the cost of the reorders.
+  test_case({1, 16, 4, 4}, 1, false);
+
+  // The 3x3 convolutions save more than the reorders cost.
+  test_case({1, 64, 28, 28}, 3, true);
+}
+
 #endif
 
 }  // namespace test
@@ -205,7 +205,7 @@ static const ONNX_NAMESPACE::GraphProto CreateSubgraph(const RunOptions& options
   // Convert iter_num to float
   {
     auto& cast = graph.AddNode("iter_num_cast", "Cast", "Cast iter_num to float", {&iter_num_in}, {&iter_num_float});
-    cast.AddAttribute("to", int64_t{TensorProto_DataType_FLOAT});
+    cast.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
   }
 
   // Unsqueeze iter_num_float, if initial iter_num is scalar.
@@ -1041,6 +1041,104 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// The subgraph outputs of one iteration are moved into the feeds of the next one and into the per-iteration scan
+// outputs. Check the values across several iterations, including the last iteration's outputs that are read after
+// the loop to produce the final loop carried values and the last row of the scan output.
+TEST(Loop, LoopCarriedAndScanOutputsAcrossIterations) {
+  auto create_subgraph = []() {
+    Model model("Loop carried and scan outputs", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, a_in, b_in.
+
+         cond_in     a_in   b_in        iter_num_in
+            |          \   /  \             |
+       [Identity]      [Add]  [Identity]   [Cast]
+            |            |        |          |
+         cond_out      a_out    b_out     iter_num_f
+                         \                  /
+                          \------[Add]-----/
+                                   |
+                               scan_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_scalar;
+    float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_vector;
+    float_vector.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_vector.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    // graph inputs
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& a_in = graph.GetOrCreateNodeArg("a_in", &float_vector);
+    auto& b_in = graph.GetOrCreateNodeArg("b_in", &float_vector);
+
+    // graph outputs
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& a_out = graph.GetOrCreateNodeArg("a_out", &float_vector);
+    auto& b_out = graph.GetOrCreateNodeArg("b_out", &float_vector);
+    auto& scan_out = graph.GetOrCreateNodeArg("scan_out", &float_vector);
+
+    auto& iter_num_f = graph.GetOrCreateNodeArg("iter_num_f", &float_scalar);
+
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    graph.AddNode("a_add", "Add", "a_out = a_in + b_in", {&a_in, &b_in}, {&a_out});
+    graph.AddNode("b_identity", "Identity", "Forward b_in to b_out", {&b_in}, {&b_out});
+    graph.AddNode("iter_num_cast", "Cast", "Cast iter_num_in to float", {&iter_num_in}, {&iter_num_f})
+        .AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+    graph.AddNode("scan_add", "Add", "scan_out = a_out + iter_num", {&a_out, &iter_num_f}, {&scan_out});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &a_in, &b_in});
+    graph.SetOutputs({&cond_out, &a_out, &b_out, &scan_out});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  auto body = create_subgraph();
+  auto run_test = [&body](int64_t iterations) {
+    OpTester test("Loop", 11);
+    test.AddAttribute<GraphProto>("body", body);
+    test.AddInput<int64_t>("M", {1}, {iterations});
+    test.AddInput<bool>("cond", {1}, {true});
+    test.AddInput<float>("a", {2}, {1.f, 2.f});
+    test.AddInput<float>("b", {2}, {10.f, 20.f});
+
+    // after iteration i, a is {1 + 10 * (i + 1), 2 + 20 * (i + 1)} and the scan output is a + i.
+    std::vector<float> scan_out;
+    for (int64_t i = 0; i < iterations; ++i) {
+      const float a0 = 1.f + 10.f * static_cast<float>(i + 1);
+      const float a1 = 2.f + 20.f * static_cast<float>(i + 1);
+      scan_out.push_back(a0 + static_cast<float>(i));
+      scan_out.push_back(a1 + static_cast<float>(i));
+    }
+
+    const auto last = static_cast<float>(iterations);
+    test.AddOutput<float>("a_final", {2}, {1.f + 10.f * last, 2.f + 20.f * last});
+    test.AddOutput<float>("b_final", {2}, {10.f, 20.f});
+    test.AddOutput<float>("scan_out", {iterations, 2}, scan_out);
+
+    // Disable TensorRT on unsupported data type BOOL
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  };
+
+  run_test(1);
+  run_test(4);
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
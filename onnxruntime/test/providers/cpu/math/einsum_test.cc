@@ -582,6 +582,17 @@ TEST(Einsum, ExplicitEinsumAsTensorContractionSameInput) {
   test.Run();
 }
 
+// Contracting left to right creates an intermediate of shape [i, k], so 'jk,k' is contracted first instead.
+TEST(Einsum, ExplicitEinsumAsTensorContractionReordered) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,k->i");
+  test.AddInput<float>("x", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {2, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+  test.AddInput<float>("z", {4}, {1.f, 2.f, 3.f, 4.f});
+  test.AddOutput<float>("o", {3}, {170.f, 370.f, 570.f});
+  test.Run();
+}
+
 // Implicit
 TEST(Einsum, ImplicitEinsumAsTensorContraction) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -526,6 +527,49 @@ TEST(TopKOperator, TopAllExplicitAxis1DLargeInputLargestElements) {
   top_2_explicit_axis_1D_large_input<double>(11, 0);  // unsorted
 }
 
+// Long contiguous rows are split into chunks that are processed in parallel when there are fewer rows than threads.
+// The session uses a thread pool of 4 threads so that the 100000 element row is split into 4 chunks.
+template <typename T>
+static void top_k_1D_very_large_input(int opset_version, int64_t largest) {
+  std::vector<T> input_vals(100000);
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>(i % 1000);
+  }
+  input_vals[12345] = static_cast<T>(2000);
+  input_vals[50000] = static_cast<T>(2000);
+  input_vals[99999] = static_cast<T>(3000);
+  input_vals[77777] = static_cast<T>(-1);
+
+  OpTester test("TopK", opset_version);
+  if (largest != 1)
+    test.AddAttribute("largest", largest);
+
+  test.AddInput<T>("X", {100000}, input_vals);
+  test.AddInput<int64_t>("K", {1}, {3});
+
+  if (largest) {
+    test.AddOutput<T>("Values", {3}, {3000, 2000, 2000});
+    test.AddOutput<int64_t>("Indices", {3}, {99999, 12345, 50000});
+  } else {
+    test.AddOutput<T>("Values", {3}, {-1, 0, 0});
+    test.AddOutput<int64_t>("Indices", {3}, {77777, 0, 1000});
+  }
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(TopKOperator, TopK1DVeryLargeInput) {
+  top_k_1D_very_large_input<float>(11, 1);
+  top_k_1D_very_large_input<float>(11, 0);
+  top_k_1D_very_large_input<double>(11, 1);
+  top_k_1D_very_large_input<int64_t>(11, 0);
+}
+
 template <typename T>
 static void top_1_explicit_axis_MultiD_input(int opset_version, int64_t sorted = 1) {
   std::vector<T> input_vals = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
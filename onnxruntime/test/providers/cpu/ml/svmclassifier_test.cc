@@ -50,6 +50,41 @@ TEST(MLOpTest, SVMClassifierMulticlassSVC) {
   test.Run();
 }
 
+// the middle class has no support vectors so only contributes its coefficients via the other classes
+TEST(MLOpTest, SVMClassifierMulticlassSVCClassWithoutSupportVectors) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {0.5f, -1.5f, 1.f, -0.25f,
+                                          0.75f, 2.f, -1.f, 0.5f};
+  std::vector<float> support_vectors = {0.f, 1.f, 1.f, 0.f, 2.f, 2.f, -1.f, 3.f};
+  std::vector<int64_t> classes = {10, 20, 30};
+  std::vector<int64_t> vectors_per_class = {2, 0, 2};
+  std::vector<float> rho = {0.4f, -0.2f, 0.6f};
+  std::vector<float> kernel_params = {0.5f, 0.f, 3.f};  // gamma, coef0, degree
+
+  std::vector<float> X = {0.f, 0.f, 1.f, 1.f, 2.f, 1.f, -1.f, 2.f, 2.f, 2.f};
+  std::vector<int64_t> predictions = {20, 20, 10, 10, 10};
+  std::vector<float> scores = {-0.2065307f, 1.48459f, 0.5850534f,
+                               -0.2065307f, 1.83126f, 0.2412784f,
+                               -0.08415151f, 1.243415f, -0.005778909f,
+                               0.5564662f, -0.02798282f, 0.8921564f,
+                               0.317915f, 1.024049f, -0.396631f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {5, 2}, X);
+  test.AddOutput<int64_t>("Y", {5}, predictions);
+  test.AddOutput<float>("Z", {5, 3}, scores);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMClassifierMulticlassLinearSVC) {
   OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
 
@@ -221,6 +256,49 @@ TEST(MLOpTest, SVMClassifierSVCDouble) {
   test.Run();
 }
 
+// Features with a large common offset. Computing the RBF distance as |x|^2 + |s|^2 - 2 x.s in float loses most of
+// the distance to cancellation here. The expected values are from the direct difference with double accumulation
+// of the pair scores.
+TEST(MLOpTest, SVMClassifierMulticlassSVCLargeMagnitudeFeatures) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {0.5f, -1.25f, 1.f, -0.75f, 0.25f,
+                                          1.5f, 0.75f, -1.f, -0.5f, 1.25f};
+  std::vector<float> support_vectors = {1000.25f, 999.5f, 1000.75f,
+                                        999.75f, 1000.5f, 1000.f,
+                                        1000.f, 1000.f, 999.25f,
+                                        1001.f, 999.f, 1000.5f,
+                                        999.5f, 999.75f, 1000.25f};
+  std::vector<int64_t> classes = {0, 1, 2};
+  std::vector<int64_t> vectors_per_class = {2, 1, 2};
+  std::vector<float> rho = {0.1f, -0.2f, 0.05f};
+  std::vector<float> kernel_params = {0.5f, 0.f, 3.f};  // gamma, coef0, degree
+
+  std::vector<float> X = {1000.f, 1000.f, 1000.f,
+                          1000.5f, 999.5f, 1000.5f,
+                          999.5f, 1000.25f, 999.75f,
+                          1000.75f, 999.25f, 1000.25f};
+  std::vector<int64_t> predictions = {0, 0, 1, 0};
+  std::vector<float> scores = {0.1084821f, 1.3737497f, 0.1691206f,
+                               0.42122182f, 1.0704921f, 0.01626726f,
+                               -0.11050311f, 1.1118214f, 0.21256292f,
+                               0.48657757f, 0.5522454f, -0.2458003f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {4, 3}, X);
+  test.AddOutput<int64_t>("Y", {4}, predictions);
+  test.AddOutput<float>("Z", {4, 3}, scores);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMClassifierLinear) {
   OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
 
@@ -1,8 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -154,6 +158,77 @@ TEST(NonMaxSuppressionOpTest, TwoBatches_TwoClasses) {
   test.Run();
 }
 
+// Enough (batch, class) pairs and boxes for the pairs to be split across the threads of the pool. The selected
+// indices must still come out in (batch, class) order.
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClassesMultiThreaded) {
+  constexpr int64_t num_batches = 4;
+  constexpr int64_t num_classes = 5;
+  constexpr int64_t num_boxes = 1024;
+  constexpr int64_t max_output_boxes_per_class = 4;
+
+  // boxes 2k and 2k + 1 are the same unit square, and the squares do not overlap each other.
+  std::vector<float> boxes;
+  boxes.reserve(num_batches * num_boxes * 4);
+  for (int64_t batch_index = 0; batch_index < num_batches; ++batch_index) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      const int64_t cell = box_index / 2;
+      const float y = static_cast<float>(cell / 32) * 2.0f;
+      const float x = static_cast<float>(cell % 32) * 2.0f;
+      boxes.insert(boxes.end(), {y, x, y + 1.0f, x + 1.0f});
+    }
+  }
+
+  // an odd multiplier permutes the box indices, so each pair has distinct scores in a different order.
+  std::vector<float> scores;
+  scores.reserve(num_batches * num_classes * num_boxes);
+  for (int64_t pair_index = 0; pair_index < num_batches * num_classes; ++pair_index) {
+    const int64_t multiplier = 7 + 2 * pair_index;
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      scores.push_back(static_cast<float>((box_index * multiplier) % num_boxes) / static_cast<float>(num_boxes));
+    }
+  }
+
+  // the highest scoring boxes of each pair, skipping a box whose twin was already selected.
+  std::vector<int64_t> expected;
+  for (int64_t pair_index = 0; pair_index < num_batches * num_classes; ++pair_index) {
+    const float* pair_scores = scores.data() + pair_index * num_boxes;
+    std::vector<int64_t> order(num_boxes);
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::sort(order.begin(), order.end(),
+              [pair_scores](int64_t lhs, int64_t rhs) { return pair_scores[lhs] > pair_scores[rhs]; });
+
+    std::vector<int64_t> selected;
+    for (int64_t box_index : order) {
+      if (static_cast<int64_t>(selected.size()) == max_output_boxes_per_class) {
+        break;
+      }
+
+      if (std::find(selected.begin(), selected.end(), box_index ^ 1) == selected.end()) {
+        selected.push_back(box_index);
+      }
+    }
+
+    for (int64_t box_index : selected) {
+      expected.insert(expected.end(), {pair_index / num_classes, pair_index % num_classes, box_index});
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output_boxes_per_class});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices",
+                          {num_batches * num_classes * max_output_boxes_per_class, 3}, expected);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
 TEST(NonMaxSuppressionOpTest, WithScoreThreshold) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
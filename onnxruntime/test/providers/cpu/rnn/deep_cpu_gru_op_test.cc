@@ -7,7 +7,9 @@
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 using namespace std;
 namespace onnxruntime {
@@ -212,6 +214,44 @@ TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBias) {
   DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data);
 }
 
+// Same as BidirectionalDefaultActivationsSimpleWeightsNoBias with the two directions computed concurrently.
+TEST(GRUTest, BidirectionalConcurrentDirections) {
+  OpTester test("GRU");
+  test.AddAttribute<std::vector<string>>("activations", {"Sigmoid", "Tanh", "Sigmoid", "Tanh"});
+  test.AddAttribute("direction", std::string("bidirectional"));
+  test.AddAttribute<int64_t>("hidden_size", 3);
+  test.AddAttribute<int64_t>("linear_before_reset", 0);
+
+  std::vector<float> W_data{0.1f, 0.2f, 0.3f, 1.f, 2.f, 3.f, 10.f, 11.f, 12.f,
+                            0.1f, 0.2f, 0.3f, 1.f, 2.f, 3.f, 10.f, 11.f, 12.f};
+  test.AddInput<float>("X", {2, 2, 1}, {1.f, 2.f, 10.f, 11.f});
+  test.AddInput<float>("W", {2, 9, 1}, W_data, true);
+  test.AddInput<float>("R", {2, 9, 3}, std::vector<float>(2 * 9 * 3, 0.1f), true);
+
+  test.AddOutput<float>("Y", {2, 2, 2, 3},
+                        {0.4750208f, 0.450166f, 0.4255575f,
+                         0.45016602f, 0.40131235f, 0.35434368f,
+                         0.6082785f, 0.50623393f, 0.4426924f,
+                         0.5803454f, 0.4527356f, 0.36886263f,
+                         0.6027093f, 0.5083023f, 0.44950223f,
+                         0.5754369f, 0.45485455f, 0.3747841f,
+                         0.26894143f, 0.11920292f, 0.04742587f,
+                         0.24973989f, 0.09975048f, 0.03557118f});
+  test.AddOutput<float>("Y_h", {2, 2, 3},
+                        {0.6027093f, 0.5083023f, 0.44950223f,
+                         0.5754369f, 0.45485455f, 0.3747841f,
+                         0.6082785f, 0.50623393f, 0.4426924f,
+                         0.5803454f, 0.4527356f, 0.36886263f});
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsRnnConcurrentBidirectional, "1"));
+
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
 TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBiasLinearBeforeReset) {
   std::vector<float> Y_data{
       // forward output for input sequence 0
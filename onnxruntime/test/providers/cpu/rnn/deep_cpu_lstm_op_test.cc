@@ -7,7 +7,9 @@
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
 #include "default_providers.h"
 
 using namespace std;
@@ -277,6 +279,48 @@ TEST(LSTMTest, BidirectionalSimpleWeightsNoBiasTwoRows) {
   SimpleWeightsNoBiasTwoRows("bidirectional", Y_data, Y_h_data, Y_c_data);
 }
 
+// Same as BidirectionalSimpleWeightsNoBiasTwoRows with the two directions computed concurrently.
+TEST(LSTMTest, BidirectionalConcurrentDirections) {
+  OpTester test("LSTM");
+  test.AddAttribute("direction", std::string("bidirectional"));
+  test.AddAttribute<int64_t>("hidden_size", 3);
+
+  std::vector<float> W_data{0.1f, 0.2f, 0.3f, 0.4f, 1.f, 2.f, 3.f, 4.f, 10.f, 11.f, 12.f, 13.f,
+                            0.1f, 0.2f, 0.3f, 0.4f, 1.f, 2.f, 3.f, 4.f, 10.f, 11.f, 12.f, 13.f};
+  test.AddInput<float>("X", {2, 2, 1}, {1.f, 2.f, 10.f, 11.f});
+  test.AddInput<float>("W", {2, 12, 1}, W_data, true);
+  test.AddInput<float>("R", {2, 12, 3}, std::vector<float>(2 * 12 * 3, 0.1f), true);
+
+  test.AddOutput<float>("Y", {2, 2, 2, 3},
+                        {0.28828835f, 0.36581863f, 0.45679406f,
+                         0.34526032f, 0.47220859f, 0.55850911f,
+                         0.55391603f, 0.69201493f, 0.82696019f,
+                         0.64046413f, 0.82303363f, 0.91610711f,
+                         0.84196719f, 0.89402526f, 0.91073048f,
+                         0.85882828f, 0.90703777f, 0.92382453f,
+                         0.61249432f, 0.70678632f, 0.74094619f,
+                         0.62759886f, 0.71640738f, 0.74624585f});
+  test.AddOutput<float>("Y_h", {2, 2, 3},
+                        {0.84196719f, 0.89402526f, 0.91073048f,
+                         0.85882828f, 0.90703777f, 0.92382453f,
+                         0.55391603f, 0.69201493f, 0.82696019f,
+                         0.64046413f, 0.82303363f, 0.91610711f});
+  test.AddOutput<float>("Y_c", {2, 2, 3},
+                        {1.27731147f, 1.44181041f, 1.53179041f,
+                         1.3249796f, 1.51063104f, 1.61451544f,
+                         1.27850552f, 1.46799496f, 1.57641257f,
+                         1.34960834f, 1.54772296f, 1.65633056f});
+  test.SetOutputTolerance(0.0001f);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsRnnConcurrentBidirectional, "1"));
+
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
 TEST(LSTMTest, MixedSequenceLengths) {
   // TODO: Unskip when fixed #41968513
   if (DefaultDmlExecutionProvider().get() != nullptr) {
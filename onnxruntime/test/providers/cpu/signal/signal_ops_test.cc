@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <complex>
 #include <functional>
 #include <vector>
 
@@ -66,6 +67,78 @@ static void TestRadix2DFTFloat(bool onesided, int since_version) {
   test.Run();
 }
 
+static void TestMixedRadixDFTFloat(bool onesided, int since_version) {
+  OpTester test("DFT", since_version);
+
+  vector<int64_t> shape = {1, 12, 1};
+  vector<int64_t> output_shape = {1, 12, 2};
+  output_shape[1] = onesided ? (1 + (shape[1] >> 1)) : shape[1];
+
+  vector<float> input = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  vector<float> expected_output = {78.000f, 0.000f, -6.000f, 22.3923f, -6.000f, 10.3923f, -6.000f, 6.000f,
+                                   -6.000f, 3.4641f, -6.000f, 1.6077f, -6.000f, 0.000f, -6.000f, -1.6077f,
+                                   -6.000f, -3.4641f, -6.000f, -6.000f, -6.000f, -10.3923f, -6.000f, -22.3923f};
+
+  if (onesided) {
+    expected_output.resize(14);
+  }
+  test.AddInput<float>("input", shape, input);
+  if (since_version == 20) {
+    test.AddInput<int64_t>("dft_length", {}, {12});
+    test.AddInput<int64_t>("axis", {}, {1});
+  }
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddOutput<float>("output", output_shape, expected_output);
+  test.Run();
+}
+
+// DFT of `dft_length` complex values stored as (real, imaginary) pairs, computed directly in double precision.
+// Used as the expected result for lengths that are too long to list the output.
+static vector<float> ReferenceDFT(const float* input, size_t dft_length, bool inverse) {
+  constexpr double kPi = 3.14159265358979323846;
+  const double sign = inverse ? 1.0 : -1.0;
+  vector<float> output(2 * dft_length);
+  for (size_t k = 0; k < dft_length; k++) {
+    std::complex<double> sum(0, 0);
+    for (size_t n = 0; n < dft_length; n++) {
+      const double angle = sign * 2 * kPi * static_cast<double>((k * n) % dft_length) / static_cast<double>(dft_length);
+      sum += std::complex<double>(input[2 * n], input[2 * n + 1]) * std::polar(1.0, angle);
+    }
+    if (inverse) {
+      sum /= static_cast<double>(dft_length);
+    }
+    output[2 * k] = static_cast<float>(sum.real());
+    output[2 * k + 1] = static_cast<float>(sum.imag());
+  }
+  return output;
+}
+
+// Runs a batch of complex signals whose length only has 2, 3 and 5 as prime factors through the mixed radix fft.
+static void TestMixedRadixDFTAgainstReference(int64_t dft_length, bool inverse, int since_version) {
+  OpTester test("DFT", since_version);
+
+  constexpr int64_t num_batches = 2;
+  vector<int64_t> shape = {num_batches, dft_length, 2};
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> input = random.Uniform<float>(shape, -1.f, 1.f);
+
+  vector<float> expected_output;
+  for (int64_t batch = 0; batch < num_batches; batch++) {
+    auto output = ReferenceDFT(input.data() + batch * dft_length * 2, static_cast<size_t>(dft_length), inverse);
+    expected_output.insert(expected_output.end(), output.begin(), output.end());
+  }
+
+  test.AddInput<float>("input", shape, input);
+  if (since_version == 20) {
+    test.AddInput<int64_t>("dft_length", {}, {dft_length});
+    test.AddInput<int64_t>("axis", {}, {1});
+  }
+  test.AddAttribute<int64_t>("inverse", static_cast<int64_t>(inverse));
+  test.AddOutput<float>("output", shape, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
 static void TestInverseFloat(int since_version) {
   OpTester test("DFT", since_version);
 
@@ -108,6 +181,31 @@ TEST(SignalOpsTest, DFT17_Float_radix2_onesided) { TestRadix2DFTFloat(true, kMin
 
 TEST(SignalOpsTest, DFT20_Float_radix2_onesided) { TestRadix2DFTFloat(true, kOpsetVersion20); }
 
+TEST(SignalOpsTest, DFT17_Float_mixed_radix) { TestMixedRadixDFTFloat(false, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix) { TestMixedRadixDFTFloat(false, kOpsetVersion20); }
+
+TEST(SignalOpsTest, DFT17_Float_mixed_radix_onesided) { TestMixedRadixDFTFloat(true, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix_onesided) { TestMixedRadixDFTFloat(true, kOpsetVersion20); }
+
+// 25 = 5 * 5 only uses the radix 5 butterfly.
+TEST(SignalOpsTest, DFT17_Float_radix5) { TestMixedRadixDFTAgainstReference(25, false, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_radix5) { TestMixedRadixDFTAgainstReference(25, false, kOpsetVersion20); }
+
+// 60 = 4 * 3 * 5 uses the radix 4, 3 and 5 butterflies, 400 = 4 * 4 * 5 * 5 is a common n_fft.
+TEST(SignalOpsTest, DFT17_Float_mixed_radix_4_3_5) { TestMixedRadixDFTAgainstReference(60, false, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix_4_3_5) { TestMixedRadixDFTAgainstReference(60, false, kOpsetVersion20); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix_400) { TestMixedRadixDFTAgainstReference(400, false, kOpsetVersion20); }
+
+// 30 = 2 * 3 * 5 also uses the radix 2 butterfly.
+TEST(SignalOpsTest, DFT17_Float_mixed_radix_inverse) { TestMixedRadixDFTAgainstReference(30, true, kMinOpsetVersion); }
+
+TEST(SignalOpsTest, DFT20_Float_mixed_radix_inverse) { TestMixedRadixDFTAgainstReference(60, true, kOpsetVersion20); }
+
 TEST(SignalOpsTest, DFT17_Float_inverse) {
   TestInverseFloat(kMinOpsetVersion);
 }
@@ -233,6 +331,42 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+// A frame length of 20 = 4 * 5 goes through the mixed radix fft, with the twiddle factors shared by all frames.
+TEST(SignalOpsTest, STFTFloatMixedRadix) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  constexpr int64_t signal_length = 64;
+  constexpr int64_t frame_step = 8;
+  constexpr int64_t frame_length = 20;
+  constexpr int64_t num_frames = (signal_length - frame_length) / frame_step + 1;
+  constexpr int64_t num_bins = frame_length / 2 + 1;
+
+  vector<int64_t> signal_shape = {1, signal_length, 1};
+  vector<int64_t> window_shape = {frame_length};
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> signal = random.Uniform<float>(signal_shape, -1.f, 1.f);
+  vector<float> window = random.Uniform<float>(window_shape, 0.f, 1.f);
+
+  vector<float> expected_output;
+  vector<float> frame(2 * frame_length);
+  for (int64_t i = 0; i < num_frames; i++) {
+    for (int64_t j = 0; j < frame_length; j++) {
+      frame[2 * j] = signal[i * frame_step + j] * window[j];
+      frame[2 * j + 1] = 0.f;
+    }
+    auto spectrum = ReferenceDFT(frame.data(), static_cast<size_t>(frame_length), false);
+    expected_output.insert(expected_output.end(), spectrum.begin(), spectrum.begin() + 2 * num_bins);
+  }
+
+  test.AddInput<float>("signal", signal_shape, signal);
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddInput<float>("window", window_shape, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddOutput<float>("output", {1, num_frames, num_bins, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
@@ -36,6 +36,30 @@ TEST(GatherOpTest, Gather_axis0) {
   run_test(true);
 }
 
+TEST(GatherOpTest, Gather_axis0_LargeEmbeddingTable) {
+  // 1 MB table with 64 byte rows takes the prefetching, fixed row size copy path on CPU
+  constexpr int64_t num_rows = 4096;
+  constexpr int64_t dim = 16;
+  std::vector<float> data(num_rows * dim);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+
+  const std::vector<int64_t> indices{0, 4095, 17, -1, 2048, 17, 100, -4096, 3, 999, 1000, 1001, 7, 12, 4000};
+  std::vector<float> output;
+  for (auto idx : indices) {
+    const int64_t row = idx < 0 ? idx + num_rows : idx;
+    output.insert(output.end(), data.begin() + row * dim, data.begin() + (row + 1) * dim);
+  }
+
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {num_rows, dim}, data);
+  test.AddInput<int64_t>("indices", {static_cast<int64_t>(indices.size())}, indices);
+  test.AddOutput<float>("output", {static_cast<int64_t>(indices.size()), dim}, output);
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_negative_axis) {
   // To test for NNAPI EP, we need the indices to be initializers
   auto run_test = [](bool indices_is_initializer) {
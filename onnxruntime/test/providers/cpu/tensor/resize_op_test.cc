@@ -724,6 +724,93 @@ TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric_scales) {
   run_test(true);
 }
 
+// The float NCHW bilinear path interpolates input rows along x into a row cache. Output rows 0-3 all read input
+// rows 0 and 1 and reuse both cached rows, output row 4 reads input rows 1 and 2 and reuses the cached row 1 as its
+// top row, and output row 7 clamps to the last input row, so its top and bottom rows are the same.
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_RowCache) {
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{};
+  constexpr int64_t N = 1, C = 2, H = 3, W = 3;
+  std::vector<int64_t> sizes{N, C, 8, 5};
+  test.AddAttribute("mode", "linear");
+
+  std::vector<float> X = {
+      1.0f, 2.0f, 4.0f,
+      3.0f, 7.0f, 5.0f,
+      6.0f, 0.0f, 9.0f,
+
+      10.0f, 8.0f, 2.0f,
+      4.0f, 6.0f, 12.0f,
+      0.0f, 3.0f, 5.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("", {0}, scales);
+  test.AddInput<int64_t>("sizes", {4}, sizes);
+
+  std::vector<float> Y = {
+      1.0f, 1.4f, 2.0f, 3.2f, 4.0f,
+      1.125f, 1.6f, 2.3125f, 3.3625f, 4.0625f,
+      1.875f, 2.8f, 4.1875f, 4.3375f, 4.4375f,
+      2.625f, 4.0f, 6.0625f, 5.3125f, 4.8125f,
+      3.5625f, 4.4125f, 5.6875f, 5.725f, 5.75f,
+      4.6875f, 4.0375f, 3.0625f, 5.575f, 7.25f,
+      5.8125f, 3.6625f, 0.4375f, 5.425f, 8.75f,
+      6.0f, 3.6f, 0.0f, 5.4f, 9.0f,
+
+      10.0f, 9.2f, 8.0f, 4.4f, 2.0f,
+      9.625f, 8.925f, 7.875f, 4.725f, 2.625f,
+      7.375f, 7.275f, 7.125f, 6.675f, 6.375f,
+      5.125f, 5.625f, 6.375f, 8.625f, 10.125f,
+      3.25f, 4.125f, 5.4375f, 8.5875f, 10.6875f,
+      1.75f, 2.775f, 4.3125f, 6.5625f, 8.0625f,
+      0.25f, 1.425f, 3.1875f, 4.5375f, 5.4375f,
+      0.0f, 1.2f, 3.0f, 4.2f, 5.0f};
+
+  test.AddOutput<float>("Y", sizes, Y);
+  test.Run();
+}
+
+// Downsampling skips input rows, so every output row fills both cached rows. The cache is per channel and must not
+// carry rows over from the previous image of the batch.
+TEST(ResizeOpTest, ResizeOpLinearDownSampleTest_4DBilinear_RowCacheBatch) {
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{};
+  constexpr int64_t N = 2, C = 1, H = 5, W = 4;
+  std::vector<int64_t> sizes{N, C, 2, 3};
+  test.AddAttribute("mode", "linear");
+
+  std::vector<float> X = {
+      0.0f, 1.0f, 2.0f, 3.0f,
+      4.0f, 5.0f, 6.0f, 0.0f,
+      1.0f, 2.0f, 3.0f, 4.0f,
+      5.0f, 6.0f, 0.0f, 1.0f,
+      2.0f, 3.0f, 4.0f, 5.0f,
+
+      6.0f, 0.0f, 1.0f, 2.0f,
+      3.0f, 4.0f, 5.0f, 6.0f,
+      0.0f, 1.0f, 2.0f, 3.0f,
+      4.0f, 5.0f, 6.0f, 0.0f,
+      1.0f, 2.0f, 3.0f, 4.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("", {0}, scales);
+  test.AddInput<int64_t>("sizes", {4}, sizes);
+
+  std::vector<float> Y = {
+      3.1666667f, 4.5f, 1.4583333f,
+      4.4166667f, 3.125f, 1.8333333f,
+
+      3.625f, 3.5f, 4.8333333f,
+      3.4166667f, 4.75f, 1.7083333f};
+
+  test.AddOutput<float>("Y", sizes, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, NhwcResizeOpLinearUpSampleTest_4DBilinear_asymmetric_uint8) {
   // To test NNAPI EP, we need the scales/sizes to be in initializers
   auto run_test = [](bool scales_in_initializer) {
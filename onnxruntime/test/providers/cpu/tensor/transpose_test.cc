@@ -689,6 +689,19 @@ TEST(TransposeOpTest, NDim) {
   TransposeTest(input_shape, input_vals, &perm, input_shape, expected_vals2);
 }
 
+// Axes of size 1 are dropped and axes that stay adjacent are merged, so this runs as perm (0, 2, 1) over (2, 3, 4).
+TEST(TransposeOpTest, MergeAdjacentAxes) {
+  std::vector<int64_t> input_shape({2, 3, 1, 2, 2});
+  std::vector<float> input_vals(24);
+  std::iota(input_vals.begin(), input_vals.end(), 0.0f);
+
+  std::vector<int64_t> perm = {0, 3, 4, 2, 1};
+  std::vector<int64_t> expected_shape({2, 2, 2, 1, 3});
+  std::vector<float> expected_vals = {0.0f, 4.0f, 8.0f, 1.0f, 5.0f, 9.0f, 2.0f, 6.0f, 10.0f, 3.0f, 7.0f, 11.0f,
+                                      12.0f, 16.0f, 20.0f, 13.0f, 17.0f, 21.0f, 14.0f, 18.0f, 22.0f, 15.0f, 19.0f, 23.0f};
+  TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+}
+
 TEST(TransposeOpTest, DoTransposeImpl) {
   std::vector<int64_t> input_shape({5, 2, 1, 3});
   std::vector<float> input_vals(30);
@@ -194,6 +194,21 @@ TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutUpperWithLocale) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerMixedAscii) {
+  // - case-INSENSITIVE approach en_US locale
+  // - ASCII-only strings take the byte-wise path, the others are converted to wchar_t
+  // - filter out MONDAY, whatever its case
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {"MonDay"}, test_locale);
+  std::vector<int64_t> dims{5};
+  std::vector<std::string> input = {"MONDAY", "Tuesday", "monday", "École", "Wednesday 42!"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<std::string> output = {"tuesday", "école", "wednesday 42!"};
+  test.AddOutput<std::string>("Y", {3}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   // Empty output case
   // - casesensitive approach
@@ -78,6 +78,21 @@ TEST(StringSplit, EdgeWhitespaceTest) {
   test.Run();
 }
 
+TEST(StringSplit, MultiTokenRowsPaddedToLastDimTest) {
+  OpTester test("StringSplit", 20);
+  test.AddInput<std::string>("X", {2, 3}, {"a,b,c,d", "e", "", "f,,g", "h,i", "j,k,l,m,n"});
+  test.AddAttribute<std::string>("delimiter", ",");
+  test.AddOutput<std::string>("Y", {2, 3, 5},
+                              {"a", "b", "c", "d", "",
+                               "e", "", "", "", "",
+                               "", "", "", "", "",
+                               "f", "", "g", "", "",
+                               "h", "i", "", "", "",
+                               "j", "k", "l", "m", "n"});
+  test.AddOutput<int64_t>("Z", {2, 3}, {4, 1, 0, 3, 2, 5});
+  test.Run();
+}
+
 TEST(StringSplit, EmptyInputTest) {
   OpTester test("StringSplit", 20);
   test.AddInput<std::string>("X", {1, 3, 1}, {"", "+", "*"});
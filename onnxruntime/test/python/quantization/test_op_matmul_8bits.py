@@ -17,9 +17,6 @@ from onnxruntime import get_available_providers
 from onnxruntime.quantization import quant_utils
 
 
-@unittest.skipIf(
-    "CUDAExecutionProvider" not in get_available_providers(), reason="CUDA is not available, skipping tests."
-)
 class TestOpMatMul8Bits(unittest.TestCase):
     @classmethod
     def setUpClass(cls):
@@ -95,6 +92,42 @@ class TestOpMatMul8Bits(unittest.TestCase):
 
         onnx.save(model, output_model_path)
 
+    def construct_model_gather(
+        self,
+        output_model_path: str,
+        tdata: onnx.TensorProto.DataType,
+        tind: onnx.TensorProto.DataType,
+        vocab_size: int = 545,
+        embedding_len: int = 228,
+    ) -> None:
+        """Create a simple onnx model with one Gather node like (input) --> Gather --> (output)."""
+        indices_name = "input"
+        output_name = "output"
+
+        weight_data = self.fill_weight_data((vocab_size, embedding_len))
+        if tdata == onnx.TensorProto.FLOAT16:
+            weight_data = weight_data.astype(np.float16)
+        initializers = [onnx.numpy_helper.from_array(weight_data, name="linear1.weight")]
+        gather_node = onnx.helper.make_node(
+            "Gather", ["linear1.weight", indices_name], [output_name], "Gather_0", axis=0
+        )
+
+        # make graph
+        input_tensor = onnx.helper.make_tensor_value_info(indices_name, tind, [-1, 1000])
+        output_tensor = onnx.helper.make_tensor_value_info(output_name, tdata, [-1, 1000, embedding_len])
+        graph_name = "gather_8bits_test"
+        graph = onnx.helper.make_graph(
+            [gather_node],
+            graph_name,
+            [input_tensor],
+            [output_tensor],
+            initializer=initializers,
+        )
+        model = onnx.helper.make_model(graph, opset_imports=[onnx.helper.make_opsetid("", 21)])
+        model.ir_version = 10  # use stable onnx ir version
+
+        onnx.save(model, output_model_path)
+
     def quant_test(
         self,
         model_fp32_path: str,
@@ -108,6 +141,7 @@ class TestOpMatMul8Bits(unittest.TestCase):
         atol: float = 0.05,
         config: str = "default",
         suffix: str = "",
+        providers: tuple[str, ...] = ("CUDAExecutionProvider",),
     ):
         use_qdq = quant_format == quant_utils.QuantFormat.QDQ
         name_prefix = "QDQ" if use_qdq else "QOperator"
@@ -151,6 +185,18 @@ class TestOpMatMul8Bits(unittest.TestCase):
             quant_nodes = {"DequantizeLinear": 1, "MatMul": 1} if use_qdq else {"MatMulNBits": 1}
         check_op_type_count(self, model_int8_path, **quant_nodes)
 
+        if "Gather" in op_types_to_quantize:
+            model_int8 = onnx.load(model_int8_path)
+            gather_node = next(node for node in model_int8.graph.node if node.op_type == "GatherBlockQuantized")
+            attrs = {attr.name: onnx.helper.get_attribute_value(attr) for attr in gather_node.attribute}
+            self.assertEqual(attrs["bits"], 8)
+            self.assertEqual(attrs["block_size"], block_size)
+            self.assertEqual(len(gather_node.input), 3 if is_symmetric else 4)
+            initializers = {init.name: init for init in model_int8.graph.initializer}
+            self.assertEqual(initializers[gather_node.input[0]].data_type, onnx.TensorProto.UINT8)
+            if not is_symmetric:
+                self.assertEqual(initializers[gather_node.input[3]].data_type, onnx.TensorProto.UINT8)
+
         if use_qdq:
             dq_qtype = onnx.TensorProto.INT8 if is_symmetric else onnx.TensorProto.UINT8
             dqnode_io_qtypes = (
@@ -182,7 +228,7 @@ class TestOpMatMul8Bits(unittest.TestCase):
                 data_reader.get_next(),
                 rtol,
                 atol,
-                providers=["CUDAExecutionProvider"],
+                providers=list(providers),
             )
         except Exception as exception:
             if "8b quantization not yet supported on this hardware platform!" in exception.args[0]:
@@ -191,6 +237,9 @@ class TestOpMatMul8Bits(unittest.TestCase):
             else:
                 raise exception
 
+    @unittest.skipIf(
+        "CUDAExecutionProvider" not in get_available_providers(), reason="CUDA is not available, skipping tests."
+    )
     def test_quantize_matmul_8bits(self):
         np.random.seed(13)
         for k in [32, 40, 256, 512, 512, 1024, 1040]:
@@ -216,5 +265,43 @@ class TestOpMatMul8Bits(unittest.TestCase):
                                 )
 
 
+    def test_quantize_gather_8bits_symmetric(self):
+        np.random.seed(13)
+        model_fp32_path = str(Path(self._tmp_model_dir.name).joinpath("gather_fp32_symmetric.onnx").absolute())
+        self.construct_model_gather(model_fp32_path, onnx.TensorProto.FLOAT, onnx.TensorProto.INT32)
+        data_reader = self.input_feeds(1, {"input": (100, 1000)}, -545, 545, np.int32)
+        # 32 splits a row into several blocks with a partial last block, 256 covers a whole row
+        for block_size in [32, 256]:
+            self.quant_test(
+                model_fp32_path,
+                data_reader,
+                block_size,
+                True,
+                op_types_to_quantize=("Gather",),
+                atol=1e-3,
+                rtol=0.01,
+                suffix="_gather",
+                providers=("CPUExecutionProvider",),
+            )
+
+    def test_quantize_gather_8bits_offsets(self):
+        np.random.seed(13)
+        model_fp32_path = str(Path(self._tmp_model_dir.name).joinpath("gather_fp16_offset.onnx").absolute())
+        self.construct_model_gather(model_fp32_path, onnx.TensorProto.FLOAT16, onnx.TensorProto.INT64)
+        data_reader = self.input_feeds(1, {"input": (100, 1000)}, -545, 545, np.int64)
+        for block_size in [32, 256]:
+            self.quant_test(
+                model_fp32_path,
+                data_reader,
+                block_size,
+                False,
+                op_types_to_quantize=("Gather",),
+                atol=1e-3,
+                rtol=0.01,
+                suffix="_gather",
+                providers=("CPUExecutionProvider",),
+            )
+
+
 if __name__ == "__main__":
     unittest.main()